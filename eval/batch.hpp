@@ -0,0 +1,116 @@
+#pragma once
+#include "numeric_methods.hpp"
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+// Пакетный режим: задания читаются из файла, решаются пулом потоков,
+// результаты пишутся в CSV в порядке заданий.
+
+// Вызывает body(i) для всех i из [0, count). Потоки забирают индексы
+// порциями по chunk, так что задания разной длительности делятся поровну.
+// threads = 0 означает std::thread::hardware_concurrency().
+template <typename Body>
+void parallel_for(size_t count, Body body, size_t threads = 0, size_t chunk = 256) {
+    if (threads == 0) {
+        threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    threads = max<size_t>(min(threads, (count + chunk - 1) / chunk), 1);
+
+    atomic<size_t> next(0);
+    auto work = [&]() {
+        while (true) {
+            size_t first = next.fetch_add(chunk);
+            if (first >= count) {
+                return;
+            }
+            size_t last = min(first + chunk, count);
+            for (size_t i = first; i < last; i++) {
+                body(i);
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Файл заданий: по одному заданию на строку, Columns чисел через пробелы.
+// Пустые строки и строки, начинающиеся с '#', пропускаются.
+template <size_t Columns>
+vector<array<double, Columns>> read_jobs(const string& path) {
+    ifstream in(path);
+    if (!in.is_open()) {
+        throw runtime_error("Не удалось открыть файл заданий " + path);
+    }
+
+    vector<array<double, Columns>> jobs;
+    string line;
+    size_t line_number = 0;
+    while (getline(in, line)) {
+        line_number++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == string::npos || line[start] == '#') {
+            continue;
+        }
+
+        array<double, Columns> job;
+        const char* cursor = line.c_str();
+        for (auto& value : job) {
+            char* end;
+            value = strtod(cursor, &end);
+            if (end == cursor) {
+                throw runtime_error(path + ":" + to_string(line_number) + ": ожидается " +
+                                    to_string(Columns) + " числа");
+            }
+            cursor = end;
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+// Разбор аргументов "--batch <задания> [результат.csv] [потоки]".
+// Возвращает false, если программа запущена не в пакетном режиме; при
+// неверных аргументах бросает invalid_argument с подсказкой.
+struct BatchOptions {
+    string jobs_path;
+    string output_path;
+    size_t threads = 0;
+};
+
+inline bool parse_batch_options(int argc, char** argv, BatchOptions& options) {
+    if (argc < 2 || string(argv[1]) != "--batch") {
+        return false;
+    }
+    const string usage = string("использование: ") + argv[0] + " --batch <задания> [результат.csv] [потоки]";
+    if (argc < 3 || argc > 5) {
+        throw invalid_argument(usage);
+    }
+    options.jobs_path = argv[2];
+    if (argc > 3) {
+        options.output_path = argv[3];
+    }
+    if (argc > 4) {
+        string threads = argv[4];
+        if (threads.empty() || threads.find_first_not_of("0123456789") != string::npos) {
+            throw invalid_argument("число потоков должно быть целым неотрицательным: " + threads + "\n" + usage);
+        }
+        try {
+            options.threads = stoul(threads);
+        } catch (const out_of_range&) {
+            throw invalid_argument("слишком большое число потоков: " + threads);
+        }
+    }
+    return true;
+}
\ No newline at end of file
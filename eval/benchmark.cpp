@@ -0,0 +1,253 @@
+#include "numeric_methods.hpp"
+#include "sphere.hpp"
+#include "batch.hpp"
+
+#include <chrono>
+#include <random>
+#include <string>
+
+template <typename Func>
+double time_seconds(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+// count отрезков, каждый из которых содержит ровно один корень
+// test_function: отрезки перемены знака на сетке из 1000 шагов, границы
+// которых случайно раздвинуты не больше чем на треть шага.
+vector<Interval> make_brackets(size_t count) {
+    double A = -24.0, B = 1.0;
+    int N = 1000;
+    double h = (B - A) / N;
+    auto base = find_sign_change_intervals(A, B, test_function, N);
+
+    mt19937 gen(1);
+    uniform_real_distribution<double> jitter(0.0, h / 3.0);
+    vector<Interval> intervals;
+    intervals.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const Interval& interval = base[i % base.size()];
+        intervals.emplace_back(interval.a - jitter(gen), min(interval.b + jitter(gen), B));
+    }
+    return intervals;
+}
+
+void bench_batch_refinement() {
+    size_t count = 1000000;
+    double eps = 1e-12;
+    auto intervals = make_brackets(count);
+    auto f = [](double x) { return test_function(x); };
+
+    cout << "Уточнение " << count << " отрезков бисекцией, eps = " << eps << endl;
+    cout << "Время, с   Отрезков/с   Вариант" << endl;
+
+    auto report = [&](const string& name, double time) {
+        cout << left << setw(11) << fixed << setprecision(4) << time
+             << setw(13) << scientific << setprecision(3) << count / time << defaultfloat << name << endl;
+    };
+
+    function<double(double)> erased = test_function;
+    double checksum = 0;
+    report("std::function, по одному", time_seconds([&]() {
+        for (const auto& interval : intervals) {
+            checksum += bisection_method(interval, erased, eps).root;
+        }
+    }));
+    report("лямбда, по одному", time_seconds([&]() {
+        for (const auto& interval : intervals) {
+            checksum += bisection_method(interval, f, eps).root;
+        }
+    }));
+
+    vector<SolutionResult> batch;
+    size_t hardware = max<size_t>(thread::hardware_concurrency(), 1);
+    for (size_t threads = 1; threads <= hardware; threads *= 2) {
+        report("bisection_batch, потоков: " + to_string(threads), time_seconds([&]() {
+            batch = bisection_batch(intervals, f, eps, threads);
+        }));
+    }
+
+    // Пакетный вариант обязан давать те же корни, что и поштучный.
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; i += 997) {
+        if (batch[i].root != bisection_method(intervals[i], f, eps).root) {
+            mismatches++;
+        }
+    }
+    cout << "Расхождений с bisection_method: " << mismatches << " (контрольная сумма " << checksum << ")" << endl;
+}
+
+void bench_methods() {
+    size_t count = 1000000;
+    double eps = 1e-12;
+    auto intervals = make_brackets(count);
+    auto f = [](double x) { return test_function(x); };
+    auto df = [](double x) { return test_derivative(x); };
+
+    cout << "Сравнение методов на " << count << " отрезках, eps = " << eps << endl;
+    cout << "Время, с   Вычислений   Вне отрезка  Не сошлось  Метод" << endl;
+
+    auto run = [&](const string& name, auto solve) {
+        size_t evaluations = 0, outside = 0, failed = 0;
+        double time = time_seconds([&]() {
+            for (const auto& interval : intervals) {
+                SolutionResult result = solve(interval);
+                evaluations += result.evaluations;
+                outside += result.root < interval.a || result.root > interval.b;
+                failed += result.status != SolveStatus::converged;
+            }
+        });
+        cout << left << setw(11) << fixed << setprecision(4) << time
+             << setw(13) << setprecision(2) << double(evaluations) / count << defaultfloat
+             << setw(13) << outside << setw(12) << failed << name << endl;
+    };
+
+    run("бисекция", [&](const Interval& in) { return bisection_method(in, f, eps); });
+    run("Ньютон, x0 = середина", [&](const Interval& in) { return newton_method(in, f, df, (in.a + in.b) / 2, eps); });
+    run("модифицированный Ньютон", [&](const Interval& in) { return modified_newton_method(in, f, df, (in.a + in.b) / 2, eps); });
+    run("секущие", [&](const Interval& in) { return secant_method(in, f, eps); });
+    run("Брент", [&](const Interval& in) { return brent_method(in, f, eps); });
+}
+
+// Прежняя реализация отделения корней: два вычисления f на отрезок через
+// std::function и push_back на каждую находку.
+vector<Interval> find_sign_change_intervals_reference(double A, double B, function<double(double)> f, int N) {
+    vector<Interval> intervals;
+    double h = (B - A) / N;
+
+    for (int i = 0; i < N; i++) {
+        double x1 = A + i * h;
+        double x2 = A + (i + 1) * h;
+
+        if (f(x1) * f(x2) <= 0) {
+            intervals.push_back(Interval(x1, x2));
+        }
+    }
+
+    return intervals;
+}
+
+void bench_scan() {
+    double A = -24.0, B = 1.0;
+    int N = 100000000;
+    auto f = [](double x) { return test_function(x); };
+
+    cout << "Отделение корней на [" << A << ", " << B << "], N = " << N << endl;
+    cout << "Время, с   Узлов/с      Отрезков  Вариант" << endl;
+
+    auto report = [&](const string& name, double time, size_t found) {
+        cout << left << setw(11) << fixed << setprecision(4) << time
+             << setw(13) << scientific << setprecision(3) << N / time << defaultfloat
+             << setw(10) << found << name << endl;
+    };
+
+    vector<Interval> reference;
+    double time = time_seconds([&]() {
+        reference = find_sign_change_intervals_reference(A, B, test_function, N);
+    });
+    report("прежняя реализация", time, reference.size());
+
+    size_t hardware = max<size_t>(thread::hardware_concurrency(), 1);
+    vector<Interval> intervals;
+    for (size_t threads = 1; threads <= hardware; threads *= 2) {
+        time = time_seconds([&]() {
+            intervals = find_sign_change_intervals(A, B, f, N, threads);
+        });
+        report("find_sign_change_intervals, потоков: " + to_string(threads), time, intervals.size());
+    }
+
+    bool same = intervals.size() == reference.size();
+    for (size_t i = 0; same && i < intervals.size(); i++) {
+        same = intervals[i].a == reference[i].a && intervals[i].b == reference[i].b;
+    }
+    cout << "Совпадает с прежней реализацией: " << (same ? "да" : "нет") << endl;
+}
+
+void bench_sphere_table() {
+    size_t count = 10000000;
+    size_t catalogue = 1000;
+
+    // Радиусы случайные, плотности берутся из каталога материалов, поэтому
+    // повторяются.
+    mt19937 gen(1);
+    uniform_real_distribution<double> radius(0.05, 2.0);
+    uniform_real_distribution<double> catalogue_density(100.0, 999.0);
+    uniform_int_distribution<size_t> pick(0, catalogue - 1);
+    vector<double> densities(catalogue);
+    for (auto& density : densities) {
+        density = catalogue_density(gen);
+    }
+    vector<pair<double, double>> materials(count);
+    for (auto& [r, density] : materials) {
+        r = radius(gen);
+        density = densities[pick(gen)];
+    }
+
+    cout << "Таблица глубин погружения для " << count << " материалов (" << catalogue << " разных плотностей)" << endl;
+    cout << "Время, с   Материалов/с  Вариант" << endl;
+    auto report = [&](const string& name, double time) {
+        cout << left << setw(11) << fixed << setprecision(4) << time
+             << setw(14) << scientific << setprecision(3) << count / time << defaultfloat << name << endl;
+    };
+
+    vector<double> reference(count), depths(count);
+    report("бисекция (прежний solve_depth)", time_seconds([&]() {
+        for (size_t i = 0; i < count; i++) {
+            reference[i] = solve_depth_bisection(materials[i].first, materials[i].second);
+        }
+    }));
+    report("Кардано + Ньютон", time_seconds([&]() {
+        for (size_t i = 0; i < count; i++) {
+            depths[i] = solve_depth(materials[i].first, materials[i].second);
+        }
+    }));
+
+    double max_difference = 0, max_residual = 0;
+    for (size_t i = 0; i < count; i++) {
+        auto [r, density] = materials[i];
+        double h = depths[i];
+        max_difference = max(max_difference, abs(h - reference[i]));
+        double residual = h * h * (3.0 * r - h) - 4.0 * density / WATER_DENSITY * r * r * r;
+        max_residual = max(max_residual, abs(residual) / (r * r * r));
+    }
+
+    DepthCache cache;
+    report("Кардано + Ньютон, кэш по плотности", time_seconds([&]() {
+        for (size_t i = 0; i < count; i++) {
+            depths[i] = cache.solve_depth(materials[i].first, materials[i].second);
+        }
+    }));
+
+    size_t hardware = max<size_t>(thread::hardware_concurrency(), 1);
+    for (size_t threads = 2; threads <= hardware; threads *= 2) {
+        report("Кардано + Ньютон, потоков: " + to_string(threads), time_seconds([&]() {
+            parallel_for(count, [&](size_t i) {
+                depths[i] = solve_depth(materials[i].first, materials[i].second);
+            }, threads, 4096);
+        }));
+    }
+
+    cout << "Наибольшее отличие от бисекции: " << max_difference
+         << ", наибольшая относительная невязка: " << max_residual
+         << ", попаданий в кэш: " << cache.hits << " из " << count << endl;
+}
+
+int main(int argc, char** argv) {
+    string section = argc > 1 ? argv[1] : "all";
+
+    if (section == "all" || section == "batch") {
+        bench_batch_refinement();
+    }
+    if (section == "all" || section == "methods") {
+        bench_methods();
+    }
+    if (section == "all" || section == "sphere") {
+        bench_sphere_table();
+    }
+    if (section == "all" || section == "scan") {
+        bench_scan();
+    }
+    return 0;
+}
\ No newline at end of file
@@ -1,4 +1,8 @@
 #include "numeric_methods.hpp"
+#include "batch.hpp"
+
+#include <chrono>
+#include <limits>
 
 void print_header() {
     cout << "=========================================" << endl;
@@ -19,6 +23,22 @@ void print_parameters(double A, double B) {
     cout << endl;
 }
 
+void print_status(const SolutionResult& result) {
+    switch (result.status) {
+    case SolveStatus::zero_derivative:
+        cout << "Предупреждение: производная близка к нулю!" << endl;
+        break;
+    case SolveStatus::flat_function:
+        cout << "Предупреждение: значения функции слишком близки!" << endl;
+        break;
+    case SolveStatus::max_iterations:
+        cout << "Предупреждение: достигнуто максимальное число итераций!" << endl;
+        break;
+    case SolveStatus::converged:
+        break;
+    }
+}
+
 void solve_on_interval(const Interval& interval, function<double(double)> f, 
                       function<double(double)> df, double eps, int pres) {
     
@@ -43,6 +63,7 @@ void solve_on_interval(const Interval& interval, function<double(double)> f,
     cin >> x0_newton;
     
     SolutionResult newton = newton_method(interval, f, df, x0_newton, eps);
+    print_status(newton);
     
     cout << "Начальное приближение: x0 = " << x0_newton << endl;
     cout << "Количество шагов: " << newton.iterations << endl;
@@ -57,6 +78,7 @@ void solve_on_interval(const Interval& interval, function<double(double)> f,
     cin >> x0_modified;
     
     SolutionResult modified = modified_newton_method(interval, f, df, x0_modified, eps);
+    print_status(modified);
     
     cout << "Начальное приближение: x0 = " << x0_modified << endl;
     cout << "Количество шагов: " << modified.iterations << endl;
@@ -69,11 +91,25 @@ void solve_on_interval(const Interval& interval, function<double(double)> f,
     cout << "Начальные приближения: x0 = " << interval.a << ", x1 = " << interval.b << endl;
     
     SolutionResult secant = secant_method(interval, f, eps);
+    print_status(secant);
     
     cout << "Количество шагов: " << secant.iterations << endl;
     cout << "Приближенное решение: x = " << fixed << setprecision(pres) << secant.root << endl;
     cout << "|x_m - x_{m-1}|: " << secant.last_diff << endl;
     cout << "Абсолютная величина невязки: |f(x)| = " << secant.residual << endl;
+    
+    // 5. Метод Брента
+    cout << "\n5. МЕТОД БРЕНТА" << endl;
+    cout << "Начальные приближения: a = " << interval.a << ", b = " << interval.b << endl;
+    
+    SolutionResult brent = brent_method(interval, f, eps);
+    print_status(brent);
+    
+    cout << "Количество шагов: " << brent.iterations << endl;
+    cout << "Вычислений функции: " << brent.evaluations << endl;
+    cout << "Приближенное решение: x = " << fixed << setprecision(pres) << brent.root << endl;
+    cout << "Длина последнего отрезка: " << brent.last_diff << endl;
+    cout << "Абсолютная величина невязки: |f(x)| = " << brent.residual << endl;
 }
 
 void run_solver() {
@@ -156,7 +192,67 @@ void run_solver() {
     }
 }
 
-int main() {
+// Пакетный режим: строки "A B N eps" из файла заданий. Для каждого задания
+// корни отделяются на сетке из N отрезков и уточняются методом Брента; в
+// CSV по строке на корень, задания без корней строк не дают.
+int run_batch(const BatchOptions& options) {
+    auto jobs = read_jobs<4>(options.jobs_path);
+    vector<vector<pair<Interval, SolutionResult>>> roots(jobs.size());
+    auto f = [](double x) { return test_function(x); };
+
+    auto start = chrono::high_resolution_clock::now();
+    parallel_for(jobs.size(), [&](size_t i) {
+        double A = jobs[i][0], B = jobs[i][1], eps = jobs[i][3];
+        // Приведение к int вне его диапазона (и NaN) не определено
+        if (!(jobs[i][2] >= 1 && jobs[i][2] <= numeric_limits<int>::max())) {
+            return;
+        }
+        int N = int(jobs[i][2]);
+        if (A > B || eps <= 0) {
+            return;
+        }
+        // Параллельно решаются задания, сетка каждого сканируется в одном потоке.
+        for (const auto& interval : find_sign_change_intervals(A, B, f, N, 1)) {
+            roots[i].emplace_back(interval, brent_method(interval, f, eps));
+        }
+    }, options.threads, 1);
+    auto end = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+
+    ofstream file;
+    if (!options.output_path.empty()) {
+        file.open(options.output_path);
+        if (!file.is_open()) {
+            throw runtime_error("Не удалось открыть файл " + options.output_path);
+        }
+    }
+    ostream& out = options.output_path.empty() ? cout : file;
+
+    out << "job,A,B,N,eps,a,b,root,iterations,evaluations,residual\n" << setprecision(15);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        for (const auto& [interval, result] : roots[i]) {
+            out << i + 1 << ',' << jobs[i][0] << ',' << jobs[i][1] << ',' << int(jobs[i][2]) << ',' << jobs[i][3] << ','
+                << interval.a << ',' << interval.b << ',' << result.root << ',' << result.iterations << ','
+                << result.evaluations << ',' << result.residual << '\n';
+        }
+    }
+
+    cerr << "Заданий: " << jobs.size() << ", время решения: " << seconds << " с, "
+         << jobs.size() / seconds << " заданий/с" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    try {
+        BatchOptions options;
+        if (parse_batch_options(argc, argv, options)) {
+            return run_batch(options);
+        }
+    } catch (const exception& e) {
+        cerr << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
     run_solver();
     return 0;
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <cmath>
 #include <iomanip>
 #include <functional>
+#include <thread>
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
@@ -12,27 +15,384 @@ struct Interval {
     Interval(double start, double end) : a(start), b(end) {}
 };
 
+// Чем закончился расчёт. Методы ничего не печатают, предупреждения
+// выводит вызывающий код.
+enum class SolveStatus {
+    converged,
+    zero_derivative,   // производная близка к нулю
+    flat_function,     // значения функции слишком близки
+    max_iterations,
+};
+
 // Результат решения методом
 struct SolutionResult {
     double root;
     int iterations;
     double last_diff;
     double residual;
+    // Вычисления f и её производной за всё решение.
+    int evaluations = 0;
+    SolveStatus status = SolveStatus::converged;
 };
 
-// Функции для решения уравнений
-vector<Interval> find_sign_change_intervals(double A, double B, function<double(double)> f, int N = 1000);
+const int max_iterations = 1000;
+
+// Размер блока сетки, который поток вычисляет за один проход.
+const size_t scan_block = 4096;
+
+// Отделение корней: отрезки [x_i, x_{i+1}] сетки x_i = A + i*h, на
+// концах которых f имеет разные знаки (или обращается в ноль). f считается
+// один раз в каждом узле: блок значений сначала заполняется целиком, затем
+// проверяется проходом без ветвлений, и только блоки с переменой знака
+// просматриваются ещё раз, чтобы выписать отрезки. Сетка делится между
+// потоками на непрерывные части; threads = 0 означает
+// std::thread::hardware_concurrency().
+template <typename F>
+vector<Interval> find_sign_change_intervals(double A, double B, F f, int N = 1000, size_t threads = 0) {
+    double h = (B - A) / N;
+    size_t count = N > 0 ? size_t(N) : 0;
+    if (threads == 0) {
+        threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    threads = max<size_t>(min(threads, (count + scan_block - 1) / scan_block), 1);
+
+    vector<vector<Interval>> found(threads);
+    auto work = [&](size_t t) {
+        F local = f;
+        size_t first = count * t / threads;
+        size_t last = count * (t + 1) / threads;
+        vector<double> values(scan_block + 1);
+
+        for (size_t start = first; start < last; start += scan_block) {
+            size_t m = min(scan_block, last - start);
+            for (size_t j = 0; j <= m; j++) {
+                values[j] = local(A + double(start + j) * h);
+            }
+
+            size_t changes = 0;
+            for (size_t j = 0; j < m; j++) {
+                changes += values[j] * values[j + 1] <= 0;
+            }
+            if (changes == 0) {
+                continue;
+            }
+            for (size_t j = 0; j < m; j++) {
+                if (values[j] * values[j + 1] <= 0) {
+                    found[t].push_back(Interval(A + double(start + j) * h, A + double(start + j + 1) * h));
+                }
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    vector<Interval> intervals;
+    for (auto& part : found) {
+        intervals.insert(intervals.end(), part.begin(), part.end());
+    }
+    return intervals;
+}
+
+// Методы уточнения принимают функцию любого вызываемого типа по значению:
+// лямбды и указатели на функции вызываются напрямую, без std::function.
+template <typename F>
+SolutionResult bisection_method(const Interval& interval, F f, double eps) {
+    double a = interval.a;
+    double b = interval.b;
+    double fa = f(a);
+    int iterations = 0;
+    double c, fc;
+
+    do {
+        iterations++;
+        c = (a + b) / 2.0;
+        fc = f(c);
+
+        if (fa * fc < 0) {
+            b = c;
+        } else {
+            a = c;
+            fa = fc;
+        }
+    } while ((b - a) > 2 * eps);
+
+    return {c, iterations, (b - a), abs(fc), iterations + 1};
+}
+
+template <typename F, typename DF>
+SolutionResult newton_method(const Interval& interval, F f, DF df, double x0, double eps) {
+    double x = x0;
+    double x_prev;
+    int iterations = 0;
+    int evaluations = 0;
+    SolveStatus status = SolveStatus::converged;
+
+    do {
+        iterations++;
+        x_prev = x;
+        double fx = f(x);
+        double dfx = df(x);
+        evaluations += 2;
+
+        if (abs(dfx) < 1e-15) {
+            status = SolveStatus::zero_derivative;
+            break;
+        }
+
+        x = x - fx / dfx;
+
+    } while (abs(x - x_prev) > eps && iterations < max_iterations);
+
+    if (status == SolveStatus::converged && abs(x - x_prev) > eps) {
+        status = SolveStatus::max_iterations;
+    }
+    return {x, iterations, abs(x - x_prev), abs(f(x)), evaluations + 1, status};
+}
+
+template <typename F, typename DF>
+SolutionResult modified_newton_method(const Interval& interval, F f, DF df, double x0, double eps) {
+    double x = x0;
+    double x_prev;
+    double df0 = df(x0);
+    int iterations = 0;
+
+    if (abs(df0) < 1e-15) {
+        return {x0, 0, 0, abs(f(x0)), 2, SolveStatus::zero_derivative};
+    }
+
+    do {
+        iterations++;
+        x_prev = x;
+        double fx = f(x);
+        x = x - fx / df0;
+
+    } while (abs(x - x_prev) > eps && iterations < max_iterations);
+
+    SolveStatus status = abs(x - x_prev) > eps ? SolveStatus::max_iterations : SolveStatus::converged;
+    return {x, iterations, abs(x - x_prev), abs(f(x)), iterations + 2, status};
+}
+
+template <typename F>
+SolutionResult secant_method(const Interval& interval, F f, double eps) {
+    double x0 = interval.a;
+    double x1 = interval.b;
+    double f0 = f(x0);
+    double f1 = f(x1);
+    double x2;
+    int iterations = 0;
+    int evaluations = 2;
+    SolveStatus status = SolveStatus::converged;
+
+    do {
+        iterations++;
+
+        if (abs(f1 - f0) < 1e-15) {
+            status = SolveStatus::flat_function;
+            break;
+        }
+
+        x2 = x1 - f1 * (x1 - x0) / (f1 - f0);
+        x0 = x1;
+        f0 = f1;
+        x1 = x2;
+        f1 = f(x1);
+        evaluations++;
+
+    } while (abs(x1 - x0) > eps && iterations < max_iterations);
+
+    if (status == SolveStatus::converged && abs(x1 - x0) > eps) {
+        status = SolveStatus::max_iterations;
+    }
+    return {x1, iterations, abs(x1 - x0), abs(f1), evaluations, status};
+}
+
+// Метод Брента: обратная квадратичная интерполяция и секущие, а если шаг
+// выходит за текущий отрезок перемены знака или сокращает его слишком
+// медленно, то бисекция. Корень всегда остаётся внутри отрезка, а
+// вычислений f обычно в несколько раз меньше, чем у бисекции. Требует
+// f(a) * f(b) <= 0; last_diff - длина итогового отрезка.
+template <typename F>
+SolutionResult brent_method(const Interval& interval, F f, double eps) {
+    double a = interval.a;
+    double b = interval.b;
+    double fa = f(a);
+    double fb = f(b);
+    int evaluations = 2;
+    int iterations = 0;
+
+    // c - второй конец отрезка перемены знака, b - лучшее приближение.
+    double c = b, fc = fb;
+    double d = b - a, e = d;
+
+    while (true) {
+        if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (abs(fc) < abs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        double tol = 2.0 * numeric_limits<double>::epsilon() * abs(b) + 0.5 * eps;
+        double m = 0.5 * (c - b);
+        if (abs(m) <= tol || fb == 0 || iterations >= max_iterations) {
+            break;
+        }
+        iterations++;
+
+        if (abs(e) >= tol && abs(fa) > abs(fb)) {
+            // Секущая по двум точкам или обратная квадратичная по трём.
+            double s = fb / fa;
+            double p, q;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                double qa = fa / fc;
+                double r = fb / fc;
+                p = s * (2.0 * m * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+
+            if (2.0 * p < min(3.0 * m * q - abs(tol * q), abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = m;
+            }
+        } else {
+            d = m;
+            e = m;
+        }
+
+        a = b;
+        fa = fb;
+        b += abs(d) > tol ? d : (m > 0 ? tol : -tol);
+        fb = f(b);
+        evaluations++;
+    }
+
+    SolveStatus status = iterations >= max_iterations ? SolveStatus::max_iterations : SolveStatus::converged;
+    return {b, iterations, abs(c - b), abs(fb), evaluations, status};
+}
+
+// Число отрезков, которые пакетная бисекция ведёт одновременно. Все
+// операции над группой записаны без ветвлений по отдельным отрезкам, так
+// что компилятор может разложить их по SIMD-регистрам.
+const size_t batch_lanes = 8;
+
+// Бисекция группы из не более чем batch_lanes отрезков. Отрезок, который
+// уже сошёлся, дальше не меняется, поэтому результаты и число итераций
+// совпадают с bisection_method.
+template <typename F>
+void bisection_lanes(const Interval* intervals, size_t count, F& f, double eps, SolutionResult* results) {
+    double a[batch_lanes], b[batch_lanes], fa[batch_lanes], c[batch_lanes], fc[batch_lanes];
+    double root[batch_lanes], residual[batch_lanes];
+    int iterations[batch_lanes];
+    bool done[batch_lanes];
+
+    // Недостающие места в группе занимает копия первого отрезка.
+    for (size_t k = 0; k < batch_lanes; k++) {
+        const Interval& interval = intervals[k < count ? k : 0];
+        a[k] = interval.a;
+        b[k] = interval.b;
+        iterations[k] = 0;
+        done[k] = false;
+        root[k] = residual[k] = 0;
+    }
+    for (size_t k = 0; k < batch_lanes; k++) {
+        fa[k] = f(a[k]);
+    }
+
+    while (true) {
+        for (size_t k = 0; k < batch_lanes; k++) {
+            c[k] = (a[k] + b[k]) / 2.0;
+        }
+        for (size_t k = 0; k < batch_lanes; k++) {
+            fc[k] = f(c[k]);
+        }
+
+        size_t active = 0;
+        for (size_t k = 0; k < batch_lanes; k++) {
+            bool run = !done[k];
+            bool left = fa[k] * fc[k] < 0;
+            b[k] = run && left ? c[k] : b[k];
+            a[k] = run && !left ? c[k] : a[k];
+            fa[k] = run && !left ? fc[k] : fa[k];
+            root[k] = run ? c[k] : root[k];
+            residual[k] = run ? fc[k] : residual[k];
+            iterations[k] += run;
+            done[k] = done[k] || !((b[k] - a[k]) > 2 * eps);
+            active += !done[k];
+        }
+        if (active == 0) {
+            break;
+        }
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        results[k] = {root[k], iterations[k], b[k] - a[k], abs(residual[k]), iterations[k] + 1};
+    }
+}
+
+// Уточнение всех отрезков сразу: группы по batch_lanes отрезков,
+// список делится между потоками на непрерывные части.
+// threads = 0 означает std::thread::hardware_concurrency().
+template <typename F>
+vector<SolutionResult> bisection_batch(const vector<Interval>& intervals, F f, double eps, size_t threads = 0) {
+    vector<SolutionResult> results(intervals.size());
+    if (threads == 0) {
+        threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    size_t groups = (intervals.size() + batch_lanes - 1) / batch_lanes;
+    threads = min(threads, max<size_t>(groups, 1));
 
-SolutionResult bisection_method(const Interval& interval, function<double(double)> f, double eps);
+    auto work = [&](size_t first_group, size_t last_group) {
+        F local = f;
+        for (size_t g = first_group; g < last_group; g++) {
+            size_t first = g * batch_lanes;
+            size_t count = min(batch_lanes, intervals.size() - first);
+            bisection_lanes(intervals.data() + first, count, local, eps, results.data() + first);
+        }
+    };
 
-SolutionResult newton_method(const Interval& interval, function<double(double)> f, 
-                           function<double(double)> df, double x0, double eps);
+    vector<thread> workers;
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back(work, groups * t / threads, groups * (t + 1) / threads);
+    }
+    work(0, groups / threads);
+    for (auto& worker : workers) {
+        worker.join();
+    }
 
-SolutionResult modified_newton_method(const Interval& interval, function<double(double)> f, 
-                                    function<double(double)> df, double x0, double eps);
+    return results;
+}
 
-SolutionResult secant_method(const Interval& interval, function<double(double)> f, double eps);
+// Тестовая функция из задания №9. Определены в заголовке, чтобы шаблонные
+// методы могли их встроить.
+inline double test_function(double x) {
+    return 5.0 * sin(2.0 * x) - sqrt(1.0 - x);
+}
 
-// Тестовая функция из задания №9
-double test_function(double x);
-double test_derivative(double x);
\ No newline at end of file
+inline double test_derivative(double x) {
+    return 10.0 * cos(2.0 * x) + 1.0 / (2.0 * sqrt(1.0 - x));
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
-#include "numeric_methods.hpp"
+#include "sphere.hpp"
+#include "batch.hpp"
 
-const double PI = 3.14159265359;
-const double WATER_DENSITY = 1000.0; // кг/м³
+#include <chrono>
 
 struct Material {
     string name;
@@ -22,34 +22,6 @@ Material materials[] = {
     {"Пчелиный воск", 950}
 };
 
-double sphere_volume(double r) {
-    return (4.0 / 3.0) * PI * pow(r, 3);
-}
-
-// Функция для нахождения глубины погружения
-// Уравнение: π*h²*(3r - h)/3 = ρ_шара * V_шара / ρ_воды
-function<double(double)> create_depth_equation(double r, double sphere_density) {
-    double target_volume = sphere_density * sphere_volume(r) / WATER_DENSITY;
-
-    return [r, target_volume](double h) -> double {
-        return PI * h * h * (3.0 * r - h) / 3.0 - target_volume;
-    };
-}
-
-double solve_depth(double r, double sphere_density) {
-    if (sphere_density >= WATER_DENSITY) {
-        return 2.0 * r;
-    }
-
-    auto depth_eq = create_depth_equation(r, sphere_density);
-    Interval search_interval(0.0, 2.0 * r);
-
-    double eps = 1e-9;
-    SolutionResult result = bisection_method(search_interval, depth_eq, eps);
-
-    return result.root;
-}
-
 void print_table(double r) {
     cout << "\n=========================================" << endl;
     cout << "ЗАДАЧА О ПОГРУЖЕНИИ ШАРА" << endl;
@@ -111,7 +83,51 @@ void solve_custom() {
     }
 }
 
-int main() {
+// Пакетный режим: строки "r плотность" из файла заданий, результат в CSV.
+int run_batch(const BatchOptions& options) {
+    auto jobs = read_jobs<2>(options.jobs_path);
+    vector<double> depths(jobs.size());
+
+    auto start = chrono::high_resolution_clock::now();
+    parallel_for(jobs.size(), [&](size_t i) {
+        double r = jobs[i][0];
+        double density = jobs[i][1];
+        depths[i] = r > 0 && density > 0 ? solve_depth(r, density) : NAN;
+    }, options.threads);
+    auto end = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+
+    ofstream file;
+    if (!options.output_path.empty()) {
+        file.open(options.output_path);
+        if (!file.is_open()) {
+            throw runtime_error("Не удалось открыть файл " + options.output_path);
+        }
+    }
+    ostream& out = options.output_path.empty() ? cout : file;
+
+    out << "r,density,depth,percentage\n" << setprecision(12);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        double r = jobs[i][0];
+        out << r << ',' << jobs[i][1] << ',' << depths[i] << ',' << depths[i] / (2.0 * r) * 100.0 << '\n';
+    }
+
+    cerr << "Заданий: " << jobs.size() << ", время решения: " << seconds << " с, "
+         << jobs.size() / seconds << " заданий/с" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    try {
+        BatchOptions options;
+        if (parse_batch_options(argc, argv, options)) {
+            return run_batch(options);
+        }
+    } catch (const exception& e) {
+        cerr << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
     double standard_r = 0.62;
     print_table(standard_r);
 
@@ -0,0 +1,105 @@
+#pragma once
+#include "numeric_methods.hpp"
+
+#include <unordered_map>
+
+const double PI = 3.14159265359;
+const double WATER_DENSITY = 1000.0; // кг/м³
+
+inline double sphere_volume(double r) {
+    return (4.0 / 3.0) * PI * pow(r, 3);
+}
+
+// Функция для нахождения глубины погружения
+// Уравнение: π*h²*(3r - h)/3 = ρ_шара * V_шара / ρ_воды
+inline function<double(double)> create_depth_equation(double r, double sphere_density) {
+    double target_volume = sphere_density * sphere_volume(r) / WATER_DENSITY;
+
+    return [r, target_volume](double h) -> double {
+        return PI * h * h * (3.0 * r - h) / 3.0 - target_volume;
+    };
+}
+
+// Прежний способ: бисекция по h до eps = 1e-9, около 30 вычислений.
+inline double solve_depth_bisection(double r, double sphere_density) {
+    if (sphere_density >= WATER_DENSITY) {
+        return 2.0 * r;
+    }
+
+    auto depth_eq = create_depth_equation(r, sphere_density);
+    Interval search_interval(0.0, 2.0 * r);
+
+    double eps = 1e-9;
+    SolutionResult result = bisection_method(search_interval, depth_eq, eps);
+
+    return result.root;
+}
+
+// Относительная глубина t = h / r зависит только от k = ρ_шара / ρ_воды:
+// после деления на π r³ / 3 уравнение становится t³ - 3t² + 4k = 0.
+// Замена t = u + 1 даёт u³ - 3u + (4k - 2) = 0 с тремя вещественными
+// корнями; нужный, из [-1, 1], по тригонометрической формуле Кардано
+// равен u = 2 cos((θ + 4π) / 3), где cos θ = 1 - 2k. Два шага Ньютона
+// по исходному многочлену убирают погрешность acos и cos.
+inline double depth_ratio(double k) {
+    if (k <= 0) {
+        return 0.0;
+    }
+    if (k >= 1) {
+        return 2.0;
+    }
+
+    // При малых k тригонометрический корень теряется в вычитании
+    // 1 + 2 cos(...) (при k < 1e-16 от него не остаётся ничего), и уточнять
+    // нечего. Тогда начальное приближение берётся из асимптотики
+    // t^2 (3 - t) = 4k: t = s + s^2 / 6 + O(s^3), s = sqrt(4k / 3).
+    double t;
+    if (k < 1e-6) {
+        double s = sqrt(4.0 * k / 3.0);
+        t = s + s * s / 6.0;
+    } else {
+        const double exact_pi = acos(-1.0);
+        double theta = acos(1.0 - 2.0 * k);
+        t = 1.0 + 2.0 * cos((theta + 4.0 * exact_pi) / 3.0);
+    }
+    for (int step = 0; step < 2; step++) {
+        double g = t * t * (t - 3.0) + 4.0 * k;
+        double dg = 3.0 * t * (t - 2.0);
+        // У краёв (t -> 0, t -> 2) производная обращается в ноль.
+        if (abs(dg) < 1e-12) {
+            break;
+        }
+        t -= g / dg;
+    }
+    return min(max(t, 0.0), 2.0);
+}
+
+inline double solve_depth(double r, double sphere_density) {
+    return r * depth_ratio(sphere_density / WATER_DENSITY);
+}
+
+// Кэш относительных глубин по плотности: глубина пропорциональна r, так
+// что для таблиц с повторяющимися материалами каждая плотность решается
+// один раз. Не потокобезопасен, каждому потоку нужен свой экземпляр.
+class DepthCache {
+    unordered_map<double, double> ratios;
+public:
+    size_t hits = 0;
+    size_t misses = 0;
+
+    double solve_depth(double r, double sphere_density) {
+        auto it = ratios.find(sphere_density);
+        if (it != ratios.end()) {
+            hits++;
+            return r * it->second;
+        }
+        misses++;
+        double ratio = depth_ratio(sphere_density / WATER_DENSITY);
+        ratios.emplace(sphere_density, ratio);
+        return r * ratio;
+    }
+
+    size_t size() const {
+        return ratios.size();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+// Интерполяционный многочлен в барицентрической форме (второго рода):
+//
+//     P(x) = sum w_i f_i / (x - z_i)  /  sum w_i / (x - z_i),
+//     w_i = 1 / prod_{j != i} (z_i - z_j).
+//
+// Веса считаются один раз на набор узлов за O(n^2), после чего значение в
+// любой точке стоит O(n) и не требует пересчёта базисных многочленов.
+class BarycentricInterpolator {
+private:
+    std::vector<double> nodes;
+    std::vector<double> values;
+    std::vector<double> weights;
+
+public:
+    BarycentricInterpolator() {}
+
+    BarycentricInterpolator(const std::vector<double>& z, const std::vector<double>& fz) {
+        setNodes(z, fz);
+    }
+
+    void setNodes(const std::vector<double>& z, const std::vector<double>& fz) {
+        nodes = z;
+        values = fz;
+        size_t count = nodes.size();
+
+        // Произведения разностей при сотнях узлов выходят за пределы double,
+        // поэтому веса накапливаются в логарифмах и нормируются на
+        // наибольший: общий множитель в дроби сокращается.
+        std::vector<double> log_weights(count, 0.0);
+        std::vector<bool> negative(count, false);
+        for (size_t i = 0; i < count; i++) {
+            for (size_t j = 0; j < count; j++) {
+                if (i != j) {
+                    double difference = nodes[i] - nodes[j];
+                    log_weights[i] -= std::log(std::abs(difference));
+                    negative[i] = negative[i] != (difference < 0);
+                }
+            }
+        }
+
+        double largest = count > 0 ? *std::max_element(log_weights.begin(), log_weights.end()) : 0.0;
+        weights.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            double weight = std::exp(log_weights[i] - largest);
+            weights[i] = negative[i] ? -weight : weight;
+        }
+    }
+
+    double evaluate(double x) const {
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            double difference = x - nodes[i];
+            if (difference == 0.0) {
+                return values[i];
+            }
+            double term = weights[i] / difference;
+            numerator += term * values[i];
+            denominator += term;
+        }
+        return numerator / denominator;
+    }
+
+    // Значения в count точках сразу. Точки обрабатываются группами по lanes,
+    // внутренний цикл по группе без ветвлений и векторизуется. Точка,
+    // совпавшая с узлом, даёт деление на ноль и нечисловую сумму; такие
+    // точки пересчитываются поштучно.
+    void evaluate(const double* x, double* result, size_t count) const {
+        const size_t lanes = 8;
+        size_t full = count - count % lanes;
+        for (size_t start = 0; start < full; start += lanes) {
+            double numerator[lanes] = {}, denominator[lanes] = {};
+            for (size_t i = 0; i < nodes.size(); i++) {
+                double node = nodes[i], weight = weights[i], value = values[i];
+                for (size_t l = 0; l < lanes; l++) {
+                    double term = weight / (x[start + l] - node);
+                    numerator[l] += term * value;
+                    denominator[l] += term;
+                }
+            }
+            for (size_t l = 0; l < lanes; l++) {
+                result[start + l] = numerator[l] / denominator[l];
+            }
+            for (size_t l = 0; l < lanes; l++) {
+                if (!std::isfinite(result[start + l])) {
+                    result[start + l] = evaluate(x[start + l]);
+                }
+            }
+        }
+        for (size_t i = full; i < count; i++) {
+            result[i] = evaluate(x[i]);
+        }
+    }
+
+    void evaluate(const std::vector<double>& x, std::vector<double>& result) const {
+        result.resize(x.size());
+        evaluate(x.data(), result.data(), x.size());
+    }
+
+    size_t size() const {
+        return nodes.size();
+    }
+};
\ No newline at end of file
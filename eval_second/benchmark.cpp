@@ -0,0 +1,509 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <sstream>
+
+#include "function.hpp"
+#include "barycentric.hpp"
+#include "newton.hpp"
+#include "nearest.hpp"
+#include "chebyshev.hpp"
+#include "spline.hpp"
+
+using namespace std;
+
+template <typename Func>
+double time_seconds(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+// Равноотстоящие узлы на [a, b] и значения f в них.
+void make_nodes(double a, double b, int n, vector<double>& z, vector<double>& fz) {
+    z.resize(n + 1);
+    fz.resize(n + 1);
+    double h = (b - a) / n;
+    for (int k = 0; k <= n; k++) {
+        z[k] = a + k * h;
+        fz[k] = f(z[k]);
+    }
+}
+
+vector<double> make_queries(double a, double b, size_t count) {
+    mt19937 gen(1);
+    uniform_real_distribution<double> point(a, b);
+    vector<double> x(count);
+    for (auto& value : x) {
+        value = point(gen);
+    }
+    return x;
+}
+
+// Формула Лагранжа в том виде, в каком она вычисляется в
+// Interpolator::lagrangeInterpolation, без печати: O(n^2) на точку.
+double lagrange_reference(const vector<double>& z, const vector<double>& fz, double x) {
+    double result = 0.0;
+    size_t n = z.size();
+    for (size_t i = 0; i < n; i++) {
+        double li = 1.0;
+        for (size_t j = 0; j < n; j++) {
+            if (i != j) {
+                li *= (x - z[j]) / (z[i] - z[j]);
+            }
+        }
+        result += fz[i] * li;
+    }
+    return result;
+}
+
+void bench_barycentric() {
+    double a = 0.0, b = 1.0;
+    size_t count = 1000000;
+    auto x = make_queries(a, b, count);
+
+    cout << "Интерполирование в " << count << " точках на [" << a << ", " << b << "]" << endl;
+    cout << "n    Время, с   Точек/с      Макс. отклонение от f  Вариант" << endl;
+
+    for (int n : {10, 50, 200}) {
+        vector<double> z, fz;
+        make_nodes(a, b, n, z, fz);
+
+        auto report = [&](const string& name, double time, size_t points, const vector<double>& result) {
+            double max_error = 0.0;
+            for (size_t i = 0; i < points; i++) {
+                max_error = max(max_error, abs(result[i] - f(x[i])));
+            }
+            cout << left << setw(5) << n << setw(11) << fixed << setprecision(4) << time
+                 << setw(13) << scientific << setprecision(3) << points / time
+                 << setw(23) << max_error << defaultfloat << name << endl;
+        };
+
+        // Формула Лагранжа при n = 200 считает 10^6 точек минуты, поэтому
+        // её скорость оценивается по части точек.
+        size_t reference_count = min(count, size_t(20000000) / ((n + 1) * (n + 1)));
+        vector<double> result(count);
+        double time = time_seconds([&]() {
+            for (size_t i = 0; i < reference_count; i++) {
+                result[i] = lagrange_reference(z, fz, x[i]);
+            }
+        });
+        report("Лагранж, " + to_string(reference_count) + " точек", time, reference_count, result);
+
+        BarycentricInterpolator interpolator;
+        time = time_seconds([&]() {
+            interpolator.setNodes(z, fz);
+        });
+        cout << left << setw(5) << n << setw(11) << fixed << setprecision(4) << time
+             << defaultfloat << "вычисление весов" << endl;
+
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                result[i] = interpolator.evaluate(x[i]);
+            }
+        });
+        report("барицентрическая, по одной точке", time, count, result);
+
+        time = time_seconds([&]() {
+            interpolator.evaluate(x, result);
+        });
+        report("барицентрическая, пакетом", time, count, result);
+    }
+}
+
+// Прежний Interpolator::newtonInterpolation без печати: на каждый запрос
+// новая таблица разностей (n+1) x (n+1) и произведения без схемы Горнера.
+double newton_reference(const vector<double>& z, const vector<double>& fz, double x) {
+    int n = (int)z.size() - 1;
+    vector<vector<double>> dd(n + 1, vector<double>(n + 1));
+    for (int i = 0; i <= n; i++) {
+        dd[i][0] = fz[i];
+    }
+    for (int j = 1; j <= n; j++) {
+        for (int i = 0; i <= n - j; i++) {
+            dd[i][j] = (dd[i + 1][j - 1] - dd[i][j - 1]) / (z[i + j] - z[i]);
+        }
+    }
+    double result = dd[0][0];
+    for (int k = 1; k <= n; k++) {
+        double term = dd[0][k];
+        for (int j = 0; j < k; j++) {
+            term *= (x - z[j]);
+        }
+        result += term;
+    }
+    return result;
+}
+
+void bench_newton() {
+    double a = 0.0, b = 1.0;
+    size_t count = 1000000;
+    auto x = make_queries(a, b, count);
+
+    cout << "Форма Ньютона, стоимость одного запроса на [" << a << ", " << b << "]" << endl;
+    cout << "n    Запросов   нс/запрос    Макс. отличие  Вариант" << endl;
+
+    for (int n : {10, 50, 200}) {
+        vector<double> z, fz;
+        make_nodes(a, b, n, z, fz);
+
+        vector<double> reference(count), result(count);
+        size_t reference_count = min(count, size_t(100000000) / ((n + 1) * (n + 1)));
+        auto report = [&](const string& name, double time, size_t queries) {
+            double max_difference = 0.0;
+            for (size_t i = 0; i < min(queries, reference_count); i++) {
+                max_difference = max(max_difference, abs(result[i] - reference[i]) / max(1.0, abs(reference[i])));
+            }
+            cout << left << setw(5) << n << setw(11) << queries
+                 << setw(13) << fixed << setprecision(1) << time / queries * 1e9
+                 << setw(15) << scientific << setprecision(2) << max_difference << defaultfloat << name << endl;
+        };
+
+        double time = time_seconds([&]() {
+            for (size_t i = 0; i < reference_count; i++) {
+                reference[i] = newton_reference(z, fz, x[i]);
+            }
+        });
+        result = reference;
+        report("прежний: таблица (n+1)^2 на запрос", time, reference_count);
+
+        NewtonForm form;
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < reference_count; i++) {
+                form.clear();
+                for (int k = 0; k <= n; k++) {
+                    form.addNode(z[k], fz[k]);
+                }
+                result[i] = form.evaluate(x[i]);
+            }
+        });
+        report("NewtonForm, addNode по узлу на запрос", time, reference_count);
+
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < reference_count; i++) {
+                form.setNodes(z, fz);
+                result[i] = form.evaluate(x[i]);
+            }
+        });
+        report("NewtonForm, setNodes на запрос", time, reference_count);
+
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                result[i] = form.evaluate(x[i]);
+            }
+        });
+        report("NewtonForm, готовая форма, Горнер", time, count);
+
+        // Наращивание формы от пустой до n + 1 узлов: в среднем O(n / 2) на узел
+        size_t repeats = max<size_t>(1, 1000000 / (n + 1));
+        time = time_seconds([&]() {
+            for (size_t r = 0; r < repeats; r++) {
+                form.clear();
+                for (int k = 0; k <= n; k++) {
+                    form.addNode(z[k], fz[k]);
+                }
+            }
+        });
+        cout << left << setw(5) << n << setw(11) << repeats * (n + 1)
+             << setw(13) << fixed << setprecision(1) << time / (repeats * (n + 1)) * 1e9
+             << setw(15) << "" << defaultfloat << "addNode, в среднем на узел" << endl;
+    }
+}
+
+struct Entry {
+    double z;
+    double fz;
+    double dist_to_x;
+};
+
+void bench_nearest() {
+    double a = 0.0, b = 1.0;
+    int n = 5;
+    size_t k = n + 1;
+    size_t count = 1000000;
+
+    cout << "Выбор " << k << " ближайших узлов, " << count << " случайных точек" << endl;
+    cout << "Узлов     Запросов   нс/запрос    Несовпадений  Вариант" << endl;
+
+    for (size_t size : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        vector<double> z, fz;
+        make_nodes(a, b, int(size - 1), z, fz);
+        double h = (b - a) / (size - 1);
+        auto x = make_queries(a, b, count);
+        auto node = [&](size_t i) { return z[i]; };
+
+        // Прежний путь: расстояния до всех узлов и полная сортировка на запрос.
+        // Запомнены первые k узлов каждого запроса, по возрастанию z.
+        size_t reference_count = max<size_t>(5, 20000000 / size);
+        vector<Entry> table(size);
+        vector<double> reference(reference_count * k);
+        double time = time_seconds([&]() {
+            for (size_t q = 0; q < reference_count; q++) {
+                for (size_t i = 0; i < size; i++) {
+                    table[i] = {z[i], fz[i], abs(z[i] - x[q])};
+                }
+                sort(table.begin(), table.end(), [](const Entry& a, const Entry& b) {
+                    return a.dist_to_x < b.dist_to_x;
+                });
+                for (size_t i = 0; i < k; i++) {
+                    reference[q * k + i] = table[i].z;
+                }
+                sort(reference.begin() + q * k, reference.begin() + (q + 1) * k);
+            }
+        });
+
+        auto report = [&](const string& name, double time, size_t queries, const vector<size_t>& start) {
+            size_t mismatches = 0;
+            for (size_t q = 0; q < min(queries, reference_count); q++) {
+                mismatches += !equal(z.begin() + start[q], z.begin() + start[q] + k, reference.begin() + q * k);
+            }
+            cout << left << setw(10) << size << setw(11) << queries
+                 << setw(13) << fixed << setprecision(1) << time / queries * 1e9 << defaultfloat
+                 << setw(14) << mismatches << name << endl;
+        };
+        vector<size_t> start(count);
+        for (size_t q = 0; q < reference_count; q++) {
+            start[q] = lower_bound(z.begin(), z.end(), reference[q * k]) - z.begin();
+        }
+        report("прежний: полная сортировка", time, reference_count, start);
+
+        vector<size_t> order(k);
+        size_t checksum = 0;
+        time = time_seconds([&]() {
+            for (size_t q = 0; q < count; q++) {
+                start[q] = nearestWindowUniform(a, h, size, x[q], k);
+                orderByDistance(node, start[q], k, x[q], order.data());
+                checksum += order[0];
+            }
+        });
+        report("равноотстоящие, по индексу", time, count, start);
+
+        time = time_seconds([&]() {
+            for (size_t q = 0; q < count; q++) {
+                start[q] = nearestWindow(z, x[q], k);
+                orderByDistance(node, start[q], k, x[q], order.data());
+                checksum += order[0];
+            }
+        });
+        report("двоичный поиск + два указателя", time, count, start);
+
+        // Пакет упорядоченных точек: сначала сортируются сами точки запроса
+        vector<double> sorted_x = x;
+        sort(sorted_x.begin(), sorted_x.end());
+        time = time_seconds([&]() {
+            nearestWindows(z, sorted_x.data(), count, k, start.data());
+        });
+        size_t batch_mismatches = 0;
+        for (size_t q = 0; q < count; q += 97) {
+            batch_mismatches += start[q] != nearestWindow(z, sorted_x[q], k);
+        }
+        cout << left << setw(10) << size << setw(11) << count
+             << setw(13) << fixed << setprecision(1) << time / count * 1e9 << defaultfloat
+             << setw(14) << batch_mismatches << "пакет упорядоченных точек (сверка с nearestWindow)" << endl;
+        cout << "Контрольная сумма порядка узлов: " << checksum << endl;
+    }
+}
+
+void bench_chebyshev() {
+    double a = 0.0, b = 10.0;
+    size_t count = 1000000;
+    auto x = make_queries(a, b, count);
+    vector<double> exact(count), result(count);
+
+    cout << "Интерполирование по всем узлам на [" << a << ", " << b << "], 10^5 точек" << endl;
+    cout << "n    Равноотстоящие  Чебышёва" << endl;
+    for (int n : {10, 20, 40, 80}) {
+        vector<double> z, fz;
+        make_nodes(a, b, n, z, fz);
+        BarycentricInterpolator uniform(z, fz);
+        z = chebyshevNodes(a, b, n + 1);
+        for (int k = 0; k <= n; k++) {
+            fz[k] = f(z[k]);
+        }
+        BarycentricInterpolator chebyshev(z, fz);
+        double uniform_error = 0.0, chebyshev_error = 0.0;
+        for (size_t i = 0; i < 100000; i++) {
+            uniform_error = max(uniform_error, abs(uniform.evaluate(x[i]) - f(x[i])));
+            chebyshev_error = max(chebyshev_error, abs(chebyshev.evaluate(x[i]) - f(x[i])));
+        }
+        cout << left << setw(5) << n << setw(16) << scientific << setprecision(2) << uniform_error
+             << chebyshev_error << defaultfloat << endl;
+    }
+
+    double time = time_seconds([&]() {
+        for (size_t i = 0; i < count; i++) {
+            exact[i] = f(x[i]);
+        }
+    });
+    cout << "\nКусочно-чебышёвское приближение f на [" << a << ", " << b << "], " << count << " точек" << endl;
+    cout << "Прямое вычисление f: " << fixed << setprecision(2) << time / count * 1e9 << " нс/точку" << defaultfloat << endl;
+    cout << "Допуск    Кусков  Степень  Вычислений f  Построение, с  Погрешность  нс/точку  нс/точку пакетом" << endl;
+
+    // Степень не выше 8 даёт больше кусков, но короче цепочку Кленшоу
+    for (auto [tolerance, max_degree] : vector<pair<double, size_t>>{{1e-6, 32}, {1e-10, 32}, {1e-14, 32}, {1e-10, 8}, {1e-14, 8}}) {
+        PiecewiseChebyshev approximation;
+        size_t evaluations = 0;
+        double build_time = time_seconds([&]() {
+            evaluations = approximation.build(f, a, b, tolerance, max_degree);
+        });
+
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                result[i] = approximation.evaluate(x[i]);
+            }
+        });
+        double max_error = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            max_error = max(max_error, abs(result[i] - exact[i]));
+        }
+        double batch_time = time_seconds([&]() {
+            approximation.evaluate(x, result);
+        });
+        for (size_t i = 0; i < count; i++) {
+            max_error = max(max_error, abs(result[i] - exact[i]));
+        }
+
+        // Сохранённое и прочитанное приближение должно давать те же значения
+        stringstream stream;
+        approximation.save(stream);
+        PiecewiseChebyshev loaded;
+        bool same = loaded.load(stream);
+        for (size_t i = 0; same && i < count; i += 101) {
+            same = loaded.evaluate(x[i]) == approximation.evaluate(x[i]);
+        }
+
+        cout << left << setw(10) << scientific << setprecision(0) << tolerance << defaultfloat
+             << setw(8) << approximation.pieceCount() << setw(9) << approximation.getDegree()
+             << setw(14) << evaluations << setw(15) << fixed << setprecision(4) << build_time
+             << setw(13) << scientific << setprecision(2) << max_error
+             << setw(10) << fixed << setprecision(2) << time / count * 1e9
+             << batch_time / count * 1e9 << defaultfloat
+             << (same ? "" : "  (чтение не совпало)") << endl;
+    }
+}
+
+// Прежний путь для плотной таблицы: n + 1 ближайших узлов и формула
+// Лагранжа по ним, без печати и без выделения памяти.
+template <size_t Count>
+double local_lagrange(const vector<double>& z, const vector<double>& fz, double a, double h, double x) {
+    size_t start = nearestWindowUniform(a, h, z.size(), x, Count);
+    double result = 0.0;
+    for (size_t i = start; i < start + Count; i++) {
+        double li = 1.0;
+        for (size_t j = start; j < start + Count; j++) {
+            if (i != j) {
+                li *= (x - z[j]) / (z[i] - z[j]);
+            }
+        }
+        result += fz[i] * li;
+    }
+    return result;
+}
+
+void bench_spline() {
+    double a = 0.0, b = 10.0;
+    size_t count = 1000000;
+    auto x = make_queries(a, b, count);
+    vector<double> exact(count), result(count);
+    for (size_t i = 0; i < count; i++) {
+        exact[i] = f(x[i]);
+    }
+
+    cout << "Кубический сплайн на [" << a << ", " << b << "], " << count << " случайных точек" << endl;
+    cout << "Узлов     Построение, с  нс/точку  Погрешность  Вариант" << endl;
+
+    for (size_t size : {size_t(100000), size_t(1000000)}) {
+        vector<double> z, fz;
+        make_nodes(a, b, int(size - 1), z, fz);
+        double h = (b - a) / (size - 1);
+
+        auto report = [&](double build_time, double time, const string& name) {
+            double max_error = 0.0;
+            for (size_t i = 0; i < count; i++) {
+                max_error = max(max_error, abs(result[i] - exact[i]));
+            }
+            cout << left << setw(10) << size << setw(15) << fixed << setprecision(4) << build_time
+                 << setw(10) << setprecision(1) << time / count * 1e9
+                 << setw(13) << scientific << setprecision(2) << max_error << defaultfloat << name << endl;
+        };
+
+        double time = time_seconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                result[i] = local_lagrange<4>(z, fz, a, h, x[i]);
+            }
+        });
+        report(0.0, time, "Лагранж, 4 ближайших узла");
+
+        NewtonForm newton;
+        time = time_seconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                size_t start = nearestWindowUniform(a, h, size, x[i], 4);
+                newton.clear();
+                for (size_t k = start; k < start + 4; k++) {
+                    newton.addNode(z[k], fz[k]);
+                }
+                result[i] = newton.evaluate(x[i]);
+            }
+        });
+        report(0.0, time, "Ньютон, 4 ближайших узла");
+
+        // Неравномерная сетка: узлы равномерной сдвинуты на четверть шага
+        vector<double> z_general = z, fz_general(size);
+        mt19937 gen(2);
+        uniform_real_distribution<double> shift(-h / 4, h / 4);
+        for (size_t k = 1; k + 1 < size; k++) {
+            z_general[k] += shift(gen);
+        }
+        for (size_t k = 0; k < size; k++) {
+            fz_general[k] = f(z_general[k]);
+        }
+
+        for (auto boundary : {CubicSpline::Boundary::natural, CubicSpline::Boundary::not_a_knot}) {
+            string name = boundary == CubicSpline::Boundary::natural ? "естественный" : "not-a-knot";
+            for (bool general : {false, true}) {
+                CubicSpline spline;
+                double build_time = time_seconds([&]() {
+                    spline.setNodes(general ? z_general : z, general ? fz_general : fz, boundary);
+                });
+                string grid = spline.isUniform() ? "равномерная сетка" : "неравномерная сетка";
+                time = time_seconds([&]() {
+                    for (size_t i = 0; i < count; i++) {
+                        result[i] = spline.evaluate(x[i]);
+                    }
+                });
+                report(build_time, time, "сплайн " + name + ", " + grid + ", по одной точке");
+                time = time_seconds([&]() {
+                    spline.evaluate(x, result);
+                });
+                report(build_time, time, "сплайн " + name + ", " + grid + ", пакетом");
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    string section = argc > 1 ? argv[1] : "all";
+
+    if (section == "all" || section == "barycentric") {
+        bench_barycentric();
+    }
+    if (section == "all" || section == "newton") {
+        bench_newton();
+    }
+    if (section == "all" || section == "nearest") {
+        bench_nearest();
+    }
+    if (section == "all" || section == "chebyshev") {
+        bench_chebyshev();
+    }
+    if (section == "all" || section == "spline") {
+        bench_spline();
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Узлы Чебышёва первого рода на [a, b] по возрастанию:
+//     z_k = (a + b) / 2 - (b - a) / 2 cos((2k + 1) pi / (2 count)).
+// В отличие от равноотстоящих узлов погрешность интерполирования по ним с
+// ростом степени убывает для любой гладкой функции.
+inline std::vector<double> chebyshevNodes(double a, double b, size_t count) {
+    const double pi = std::acos(-1.0);
+    std::vector<double> z(count);
+    for (size_t k = 0; k < count; k++) {
+        z[k] = (a + b) / 2 - (b - a) / 2 * std::cos((2 * k + 1) * pi / (2 * count));
+    }
+    return z;
+}
+
+// Кусочно-чебышёвское приближение функции на [a, b]:
+//
+//     f(x) ~ sum_k c_{p,k} T_k(t),  t = 2 (x - a_p) / h - 1  на куске p,
+//
+// куски одинаковой длины h, у всех одна степень degree. Степень и число
+// кусков подбираются по допуску, после чего значение в точке стоит
+// degree + 1 шагов рекуррентной формулы Кленшоу вместо вызова f.
+class PiecewiseChebyshev {
+private:
+    double a = 0.0, b = 1.0;
+    size_t pieces = 0;
+    size_t degree = 0;
+    std::vector<double> coefficients; // pieces строк по degree + 1
+
+    // Коэффициенты по значениям f в count узлах Чебышёва на [left, right]:
+    //     c_k = 2 / count sum_j f(t_j) cos(pi k (j + 1/2) / count).
+    template <typename Func>
+    static std::vector<double> fitPiece(Func& f, double left, double right, size_t count) {
+        const double pi = std::acos(-1.0);
+        std::vector<double> values(count);
+        for (size_t j = 0; j < count; j++) {
+            double t = std::cos(pi * (j + 0.5) / count);
+            values[j] = f((left + right) / 2 + (right - left) / 2 * t);
+        }
+        std::vector<double> c(count);
+        for (size_t k = 0; k < count; k++) {
+            double sum = 0.0;
+            for (size_t j = 0; j < count; j++) {
+                sum += values[j] * std::cos(pi * k * (j + 0.5) / count);
+            }
+            c[k] = 2.0 * sum / count;
+        }
+        c[0] /= 2;
+        return c;
+    }
+
+    // Наименьшая степень d, при которой отброшенный хвост sum_{k > d} |c_k|
+    // не превосходит tolerance. Если для этого нужны два последних
+    // коэффициента, ряд ещё не сошёлся, и возвращается c.size(). Допуск ниже
+    // ошибки округления самих коэффициентов поднимается до неё, иначе ряд
+    // не сошёлся бы ни при каком числе кусков.
+    static size_t truncatedDegree(const std::vector<double>& c, double tolerance) {
+        double largest = 0.0;
+        for (double value : c) {
+            largest = std::max(largest, std::abs(value));
+        }
+        tolerance = std::max(tolerance, c.size() * 2.2e-16 * largest);
+        double tail = 0.0;
+        size_t d = c.size() - 1;
+        while (d > 0 && tail + std::abs(c[d]) <= tolerance) {
+            tail += std::abs(c[d]);
+            d--;
+        }
+        return d + 2 < c.size() ? d : c.size();
+    }
+
+public:
+    PiecewiseChebyshev() {}
+
+    // Подбор приближения с погрешностью не больше tolerance: число кусков
+    // удваивается, пока ряд степени не выше max_degree не сойдётся на каждом.
+    // При max_pieces кусков приближение строится, даже если допуск не
+    // достигнут. Возвращает число вычислений f.
+    template <typename Func>
+    size_t build(Func f, double left, double right, double tolerance, size_t max_degree = 32, size_t max_pieces = 1 << 20) {
+        a = left;
+        b = right;
+        size_t count = max_degree + 1;
+        size_t evaluations = 0;
+        for (pieces = 1;; pieces *= 2) {
+            double h = (b - a) / pieces;
+            std::vector<std::vector<double>> fits(pieces);
+            degree = 0;
+            bool converged = true;
+            bool last = pieces >= max_pieces;
+            for (size_t p = 0; p < pieces && (converged || last); p++) {
+                fits[p] = fitPiece(f, a + p * h, a + (p + 1) * h, count);
+                evaluations += count;
+                size_t d = truncatedDegree(fits[p], tolerance);
+                converged = converged && d < count;
+                degree = std::max(degree, d);
+            }
+            if (converged || last) {
+                degree = std::min(degree, max_degree);
+                coefficients.assign(pieces * (degree + 1), 0.0);
+                for (size_t p = 0; p < pieces; p++) {
+                    std::copy(fits[p].begin(), fits[p].begin() + degree + 1, coefficients.begin() + p * (degree + 1));
+                }
+                return evaluations;
+            }
+        }
+    }
+
+    double evaluate(double x) const {
+        double u = (x - a) / (b - a) * pieces;
+        size_t p = size_t(std::min(std::max(std::floor(u), 0.0), double(pieces - 1)));
+        double t = 2.0 * (u - p) - 1.0;
+        const double* c = coefficients.data() + p * (degree + 1);
+
+        double b1 = 0.0, b2 = 0.0;
+        for (size_t k = degree; k > 0; k--) {
+            double b0 = c[k] + 2.0 * t * b1 - b2;
+            b2 = b1;
+            b1 = b0;
+        }
+        return c[0] + t * b1 - b2;
+    }
+
+    // Значения в count точках. Точки идут группами по lanes: для каждой
+    // заранее находятся кусок и t, а шаги Кленшоу по всей группе выполняются
+    // одним циклом без ветвлений.
+    void evaluate(const double* x, double* result, size_t count) const {
+        const size_t lanes = 8;
+        size_t stride = degree + 1;
+        double scale = pieces / (b - a);
+        double last = double(pieces - 1);
+        size_t full = count - count % lanes;
+        for (size_t start = 0; start < full; start += lanes) {
+            double t[lanes], b1[lanes] = {}, b2[lanes] = {};
+            size_t offset[lanes];
+            for (size_t l = 0; l < lanes; l++) {
+                double u = (x[start + l] - a) * scale;
+                double p = std::min(std::max(std::floor(u), 0.0), last);
+                t[l] = 2.0 * (u - p) - 1.0;
+                offset[l] = size_t(p) * stride;
+            }
+            for (size_t k = degree; k > 0; k--) {
+                for (size_t l = 0; l < lanes; l++) {
+                    double b0 = coefficients[offset[l] + k] + 2.0 * t[l] * b1[l] - b2[l];
+                    b2[l] = b1[l];
+                    b1[l] = b0;
+                }
+            }
+            for (size_t l = 0; l < lanes; l++) {
+                result[start + l] = coefficients[offset[l]] + t[l] * b1[l] - b2[l];
+            }
+        }
+        for (size_t i = full; i < count; i++) {
+            result[i] = evaluate(x[i]);
+        }
+    }
+
+    void evaluate(const std::vector<double>& x, std::vector<double>& result) const {
+        result.resize(x.size());
+        evaluate(x.data(), result.data(), x.size());
+    }
+
+    // Текстовый формат: заголовок, строка "a b pieces degree", затем по
+    // строке коэффициентов на кусок. Числа пишутся с 17 значащими цифрами,
+    // так что чтение восстанавливает приближение без потерь.
+    void save(std::ostream& out) const {
+        auto flags = out.flags();
+        auto old_precision = out.precision(17);
+        out << std::scientific << "piecewise-chebyshev\n"
+            << a << " " << b << " " << pieces << " " << degree << "\n";
+        for (size_t p = 0; p < pieces; p++) {
+            for (size_t k = 0; k <= degree; k++) {
+                out << coefficients[p * (degree + 1) + k] << (k < degree ? " " : "\n");
+            }
+        }
+        out.flags(flags);
+        out.precision(old_precision);
+    }
+
+    bool load(std::istream& in) {
+        std::string header;
+        if (!(in >> header) || header != "piecewise-chebyshev") {
+            return false;
+        }
+        if (!(in >> a >> b >> pieces >> degree) || pieces == 0) {
+            return false;
+        }
+        coefficients.resize(pieces * (degree + 1));
+        for (auto& c : coefficients) {
+            if (!(in >> c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t pieceCount() const {
+        return pieces;
+    }
+
+    size_t getDegree() const {
+        return degree;
+    }
+};
\ No newline at end of file
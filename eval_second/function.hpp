@@ -0,0 +1,7 @@
+#pragma once
+#include <cmath>
+
+// f(x) = 1 - exp(-x) + x^2
+inline double f(double x) {
+    return 1.0 - std::exp(-x) + x * x;
+}
\ No newline at end of file
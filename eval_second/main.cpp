@@ -6,12 +6,14 @@
 #include <random>
 #include <string>
 
-using namespace std;
+#include "function.hpp"
+#include "barycentric.hpp"
+#include "newton.hpp"
+#include "nearest.hpp"
+#include "chebyshev.hpp"
+#include "spline.hpp"
 
-// f(x) = 1 - exp(-x) + x^2
-double f(double x) {
-    return 1.0 - exp(-x) + x * x;
-}
+using namespace std;
 
 struct TableEntry {
     double z;  // аргумент
@@ -21,10 +23,19 @@ struct TableEntry {
 
 class Interpolator {
 private:
-    vector<TableEntry> table;
+    vector<TableEntry> table; // узлы по возрастанию z
+    vector<TableEntry> nearest; // n + 1 ближайших к x узлов по возрастанию расстояния
     int m = 0; // число значений в таблице
     double a = 0.0, b = 0.0; // границы отрезка
     int precision = 4; // точность вывода по умолчанию
+    bool chebyshev_nodes = false; // узлы Чебышёва вместо равноотстоящих
+    vector<double> table_z; // аргументы узлов таблицы для поиска ближайших
+    PiecewiseChebyshev approximation; // кусочно-чебышёвское приближение f
+    bool has_approximation = false;
+    CubicSpline natural_spline; // сплайны по всей таблице
+    CubicSpline not_a_knot_spline;
+    bool has_splines = false; // по одному значению сплайн не строится
+    NewtonForm newton; // форма Ньютона по ближайшим узлам
 
     // Вспомогательная функция для вычисления ширины столбца
     int getColumnWidth(const string& header, bool isNumeric = true) {
@@ -60,18 +71,31 @@ public:
         cin >> a;
         cout << "Введите правую границу отрезка b: ";
         cin >> b;
+        cout << "Узлы: 1 - равноотстоящие, 2 - Чебышёва: ";
+        int node_type;
+        cin >> node_type;
+        chebyshev_nodes = node_type == 2;
 
         cout << "\nПараметры задачи:" << endl;
         cout << "Отрезок [" << a << ", " << b << "]" << endl;
         cout << "Число значений в таблице: " << (m + 1) << endl;
+        cout << "Узлы: " << (chebyshev_nodes ? "Чебышёва" : "равноотстоящие") << endl;
 
-        // Создаем равноотстоящие узлы
+        // Создаем равноотстоящие узлы или узлы Чебышёва
         double h = (b - a) / m;
+        if (chebyshev_nodes) {
+            table_z = chebyshevNodes(a, b, m + 1);
+        } else {
+            table_z.resize(m + 1);
+            for (int k = 0; k <= m; k++) {
+                table_z[k] = a + k * h;
+            }
+        }
         table.clear();
         table.reserve(m + 1);
 
         for (int k = 0; k <= m; k++) {
-            double z = a + k * h;
+            double z = table_z[k];
             TableEntry entry;
             entry.z = z;
             entry.fz = f(z);
@@ -79,6 +103,17 @@ public:
             table.push_back(entry);
         }
 
+        // Сплайны строятся один раз по всей таблице за O(m)
+        vector<double> table_fz(m + 1);
+        for (int k = 0; k <= m; k++) {
+            table_fz[k] = table[k].fz;
+        }
+        has_splines = m >= 1;
+        if (has_splines) {
+            natural_spline.setNodes(table_z, table_fz, CubicSpline::Boundary::natural);
+            not_a_knot_spline.setNodes(table_z, table_fz, CubicSpline::Boundary::not_a_knot);
+        }
+
         cout << "\nИсходная таблица значений функции:" << endl;
 
         int w1 = 4;
@@ -97,19 +132,27 @@ public:
         }
     }
 
-    void sortTableByDistance(double x) {
-        // Вычисляем расстояния до точки x
-        for (auto& entry : table) {
+    // Выбор n + 1 ближайших к x узлов. Для равноотстоящих узлов окно
+    // ближайших находится по индексу за O(1), для узлов Чебышёва - двоичным
+    // поиском, так что время запроса почти не зависит от размера таблицы.
+    // Внутри окна узлы упорядочиваются по близости к x, как прежде при
+    // сортировке всей таблицы.
+    void selectNearestNodes(double x, int n) {
+        double h = (b - a) / m;
+        size_t count = n + 1;
+        size_t start = chebyshev_nodes ? nearestWindow(table_z, x, count)
+                                       : nearestWindowUniform(a, h, table.size(), x, count);
+        vector<size_t> order(count);
+        orderByDistance([&](size_t i) { return table[i].z; }, start, count, x, order.data());
+
+        nearest.clear();
+        for (size_t i : order) {
+            TableEntry entry = table[i];
             entry.dist_to_x = abs(entry.z - x);
+            nearest.push_back(entry);
         }
 
-        // Сортируем по возрастанию расстояния
-        sort(table.begin(), table.end(), 
-             [](const TableEntry& a, const TableEntry& b) {
-                 return a.dist_to_x < b.dist_to_x;
-             });
-
-        cout << "\nОтсортированная таблица (по близости к x = " << fixed << setprecision(precision) << x << "):" << endl;
+        cout << "\nБлижайшие к x = " << fixed << setprecision(precision) << x << " узлы таблицы:" << endl;
 
         int w1 = 4;
         int w2 = getColumnWidth("x_k");
@@ -122,11 +165,11 @@ public:
              << right << setw(w4) << "|x_k - x|" << endl;
         cout << string(w1 + w2 + w3 + w4, '-') << endl;
 
-        for (int k = 0; k <= m; k++) {
+        for (int k = 0; k <= n; k++) {
             cout << left << setw(w1) << k
-                 << right << setw(w2) << fixed << setprecision(precision) << table[k].z
-                 << right << setw(w3) << fixed << setprecision(precision) << table[k].fz
-                 << right << setw(w4) << fixed << setprecision(precision) << table[k].dist_to_x << endl;
+                 << right << setw(w2) << fixed << setprecision(precision) << nearest[k].z
+                 << right << setw(w3) << fixed << setprecision(precision) << nearest[k].fz
+                 << right << setw(w4) << fixed << setprecision(precision) << nearest[k].dist_to_x << endl;
         }
     }
 
@@ -134,7 +177,7 @@ public:
     double lagrangeInterpolation(double x, int n) {
         cout << "\nПостроение многочлена по узлам: ";
         for (int i = 0; i <= n; i++) {
-            cout << "x_" << i << "=" << table[i].z;
+            cout << "x_" << i << "=" << nearest[i].z;
             if (i < n) cout << ", ";
         }
         cout << endl;
@@ -147,12 +190,12 @@ public:
 
             for (int j = 0; j <= n; j++) {
                 if (i != j) {
-                    li *= (x - table[j].z) / (table[i].z - table[j].z);
+                    li *= (x - nearest[j].z) / (nearest[i].z - nearest[j].z);
                 }
             }
 
             sum_coefficients += li;
-            result += table[i].fz * li;
+            result += nearest[i].fz * li;
         }
 
         cout << left << setw(45) << "Контроль: сумма лагранжевых коэффициентов ="
@@ -161,21 +204,42 @@ public:
         return result;
     }
 
-    // Интерполяция Ньютона с разделенными разностями
+    // Интерполяция Ньютона с разделенными разностями. Форма Ньютона хранится
+    // между запросами: если первые узлы таблицы не изменились (та же точка
+    // x, другая степень n), достраиваются только недостающие узлы, по O(n)
+    // на узел, а при меньшей степени используется начало готовой формы.
     double newtonInterpolation(double x, int n) {
-        // Создаем таблицу разделенных разностей
-        vector<vector<double>> dd(n + 1, vector<double>(n + 1));
+        size_t common = 0;
+        while (common < newton.size() && common <= (size_t)n && newton.node(common) == nearest[common].z) {
+            common++;
+        }
+        if (common == 0 || (common < newton.size() && common <= (size_t)n)) {
+            vector<double> nodes, values;
+            for (int i = 0; i <= n; i++) {
+                nodes.push_back(nearest[i].z);
+                values.push_back(nearest[i].fz);
+            }
+            newton.setNodes(nodes, values);
+        } else {
+            for (int i = (int)common; i <= n; i++) {
+                newton.addNode(nearest[i].z, nearest[i].fz);
+            }
+        }
+
+        // Для вывода нужны только первые столбцы таблицы разностей
+        int columns = min(3, n);
+        vector<vector<double>> dd(columns + 1, vector<double>(n + 1));
 
         // Заполняем нулевой столбец (значения функции)
         for (int i = 0; i <= n; i++) {
-            dd[i][0] = table[i].fz;
+            dd[0][i] = nearest[i].fz;
         }
 
         // Вычисляем разделенные разности
-        for (int j = 1; j <= n; j++) {
+        for (int j = 1; j <= columns; j++) {
             for (int i = 0; i <= n - j; i++) {
-                dd[i][j] = (dd[i + 1][j - 1] - dd[i][j - 1]) / 
-                          (table[i + j].z - table[i].z);
+                dd[j][i] = (dd[j - 1][i + 1] - dd[j - 1][i]) /
+                          (nearest[i + j].z - nearest[i].z);
             }
         }
 
@@ -203,31 +267,41 @@ public:
 
         for (int i = 0; i <= n; i++) {
             cout << left << setw(w1) << i
-                 << right << setw(w2) << fixed << setprecision(precision) << table[i].z
-                 << right << setw(w3) << fixed << setprecision(precision + 1) << dd[i][0];
+                 << right << setw(w2) << fixed << setprecision(precision) << nearest[i].z
+                 << right << setw(w3) << fixed << setprecision(precision + 1) << dd[0][i];
 
-            for (int j = 1; j <= min(3, n - i); j++) {
-                cout << right << setw(w4) << fixed << setprecision(precision + 1) << dd[i][j];
+            for (int j = 1; j <= min(columns, n - i); j++) {
+                cout << right << setw(w4) << fixed << setprecision(precision + 1) << dd[j][i];
             }
             cout << endl;
         }
 
-        // Вычисляем значение многочлена Ньютона
-        double result = dd[0][0];
-        for (int k = 1; k <= n; k++) {
-            double term = dd[0][k];
-            for (int j = 0; j < k; j++) {
-                term *= (x - table[j].z);
-            }
-            result += term;
+        // Значение многочлена Ньютона по схеме Горнера
+        return newton.evaluate(x, n);
+    }
+
+    // Приближение f на [a, b] с заданной погрешностью: степень и число кусков
+    // подбираются автоматически, дальше значения берутся из него без
+    // вычисления f.
+    void createApproximation() {
+        cout << "\nВведите допуск кусочно-чебышёвского приближения f (0 - не строить): ";
+        double tolerance;
+        cin >> tolerance;
+        has_approximation = tolerance > 0;
+        if (!has_approximation) {
+            return;
         }
 
-        return result;
+        size_t evaluations = approximation.build(f, a, b, tolerance);
+        cout << "Кусков: " << approximation.pieceCount()
+             << ", степень: " << approximation.getDegree()
+             << ", вычислений f: " << evaluations << endl;
     }
 
     void solve() {
         setPrecision();
         createTable();
+        createApproximation();
 
         while (true) {
             double x;
@@ -249,8 +323,8 @@ public:
                 }
             }
             
-            // Сортируем таблицу по близости к x
-            sortTableByDistance(x);
+            // Выбираем узлы, ближайшие к x
+            selectNearestNodes(x, n);
 
             // Вычисления по Лагранжу
             cout << "\n=== Метод Лагранжа ===" << endl;
@@ -275,10 +349,52 @@ public:
             cout << left << setw(35) << ("Погрешность |f(x) - P_" + to_string(n) + "^N(x)| =")
                  << right << setw(precision + 12) << scientific << setprecision(precision) << error_newton << endl;
 
+            // Барицентрическая формула по тем же узлам
+            cout << "\n=== Барицентрическая формула ===" << endl;
+            vector<double> nodes, values;
+            for (int i = 0; i <= n; i++) {
+                nodes.push_back(nearest[i].z);
+                values.push_back(nearest[i].fz);
+            }
+            BarycentricInterpolator barycentric(nodes, values);
+            double pn_barycentric = barycentric.evaluate(x);
+            double error_barycentric = abs(exact_value - pn_barycentric);
+
+            cout << left << setw(35) << ("P_" + to_string(n) + "^B(x) =")
+                 << right << setw(precision + 12) << fixed << setprecision(precision + 2) << pn_barycentric << endl;
+            cout << left << setw(35) << ("Погрешность |f(x) - P_" + to_string(n) + "^B(x)| =")
+                 << right << setw(precision + 12) << scientific << setprecision(precision) << error_barycentric << endl;
+
+            // Кубические сплайны по всей таблице
+            if (has_splines) {
+                cout << "\n=== Кубический сплайн ===" << endl;
+                double natural_value = natural_spline.evaluate(x);
+                double not_a_knot_value = not_a_knot_spline.evaluate(x);
+                cout << left << setw(35) << "S_естеств(x) ="
+                     << right << setw(precision + 12) << fixed << setprecision(precision + 2) << natural_value << endl;
+                cout << left << setw(35) << "Погрешность |f(x) - S_естеств(x)| ="
+                     << right << setw(precision + 12) << scientific << setprecision(precision) << abs(exact_value - natural_value) << endl;
+                cout << left << setw(35) << "S_not-a-knot(x) ="
+                     << right << setw(precision + 12) << fixed << setprecision(precision + 2) << not_a_knot_value << endl;
+                cout << left << setw(35) << "Погрешность |f(x) - S_not-a-knot(x)| ="
+                     << right << setw(precision + 12) << scientific << setprecision(precision) << abs(exact_value - not_a_knot_value) << endl;
+            }
+
+            if (has_approximation) {
+                cout << "\n=== Кусочно-чебышёвское приближение ===" << endl;
+                double approximate = approximation.evaluate(x);
+                cout << left << setw(35) << "S(x) ="
+                     << right << setw(precision + 12) << fixed << setprecision(precision + 2) << approximate << endl;
+                cout << left << setw(35) << "Погрешность |f(x) - S(x)| ="
+                     << right << setw(precision + 12) << scientific << setprecision(precision) << abs(exact_value - approximate) << endl;
+            }
+
             // Контроль результатов
             cout << "\n=== Контроль результатов ===" << endl;
             cout << left << setw(35) << "Разность |P_L(x) - P_N(x)| ="
                  << right << setw(precision + 12) << scientific << setprecision(precision) << abs(pn_lagrange - pn_newton) << endl;
+            cout << left << setw(35) << "Разность |P_L(x) - P_B(x)| ="
+                 << right << setw(precision + 12) << scientific << setprecision(precision) << abs(pn_lagrange - pn_barycentric) << endl;
 
             // Продолжение работы
             char choice;
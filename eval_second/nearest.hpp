@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+// Выбор k узлов таблицы, ближайших к точке интерполирования, без сортировки
+// всей таблицы по расстоянию. Узлы таблицы упорядочены по возрастанию, и k
+// ближайших к x среди них всегда идут подряд, поэтому достаточно найти
+// начало этого окна.
+
+// Равноотстоящие узлы a + i h, i < count: окно из k узлов, середина которого
+// ближе всего к x, находится арифметикой по индексу за O(1).
+inline size_t nearestWindowUniform(double a, double h, size_t count, double x, size_t k) {
+    double start = std::ceil((x - a) / h - (k - 1) / 2.0 - 0.5);
+    double last = double(count - k);
+    return size_t(std::min(std::max(start, 0.0), last));
+}
+
+// Произвольные возрастающие узлы z: двоичный поиск места x в таблице, затем
+// окно расширяется двумя указателями в сторону более близкого соседа.
+// O(log N + k).
+inline size_t nearestWindow(const std::vector<double>& z, double x, size_t k) {
+    size_t right = std::lower_bound(z.begin(), z.end(), x) - z.begin();
+    size_t left = right;
+    // Окно [left, right) растёт до k узлов
+    while (right - left < k) {
+        if (left == 0) {
+            right++;
+        } else if (right == z.size() || x - z[left - 1] <= z[right] - x) {
+            left--;
+        } else {
+            right++;
+        }
+    }
+    return left;
+}
+
+// Окна для возрастающей последовательности точек x[0] <= x[1] <= ...: с ростом
+// x начало окна только сдвигается вправо, поэтому весь пакет обходится за
+// O(N + count) без двоичного поиска.
+inline void nearestWindows(const std::vector<double>& z, const double* x, size_t count, size_t k, size_t* start) {
+    size_t left = 0;
+    for (size_t i = 0; i < count; i++) {
+        while (left + k < z.size() && z[left + k] - x[i] < x[i] - z[left]) {
+            left++;
+        }
+        start[i] = left;
+    }
+}
+
+// Индексы узлов окна [start, start + k) по возрастанию расстояния до x:
+// слияние от места x в окне в обе стороны, O(k).
+template <typename Node>
+void orderByDistance(Node node, size_t start, size_t k, double x, size_t* order) {
+    size_t right = start;
+    while (right < start + k && node(right) < x) {
+        right++;
+    }
+    size_t left = right;
+    for (size_t i = 0; i < k; i++) {
+        if (right == start + k || (left > start && x - node(left - 1) <= node(right) - x)) {
+            order[i] = --left;
+        } else {
+            order[i] = right++;
+        }
+    }
+}
\ No newline at end of file
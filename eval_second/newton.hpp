@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// Интерполяционный многочлен Ньютона, который растёт по одному узлу:
+//
+//     P(x) = c_0 + c_1 (x - z_0) + ... + c_k (x - z_0)...(x - z_{k-1}),
+//     c_k = f[z_0, ..., z_k].
+//
+// Вместо всей таблицы разделённых разностей хранится её последняя строка
+// f[z_k], f[z_{k-1}, z_k], ..., f[z_0, ..., z_k]: по ней и новому узлу
+// следующая строка считается за O(n), а c_{k+1} - её последний элемент.
+// Первые k+1 коэффициентов сами задают многочлен степени k по первым k+1
+// узлам, поэтому одна построенная форма отвечает на запросы любой меньшей
+// степени.
+class NewtonForm {
+private:
+    std::vector<double> nodes;
+    std::vector<double> coefficients;
+    std::vector<double> last_row;
+
+public:
+    NewtonForm() {}
+
+    void clear() {
+        nodes.clear();
+        coefficients.clear();
+        last_row.clear();
+    }
+
+    // Построение по всем узлам сразу: таблица считается по столбцам на месте,
+    // d[i] = f[z_{i-j}, ..., z_i] после j-го столбца. Деления внутри столбца
+    // независимы, тогда как в addNode каждое ждёт предыдущее.
+    void setNodes(const std::vector<double>& z, const std::vector<double>& fz) {
+        size_t count = z.size();
+        nodes = z;
+        coefficients = fz;
+        last_row.assign(count, 0.0);
+        if (count == 0) {
+            return;
+        }
+        std::vector<double>& d = coefficients;
+        last_row[0] = d[count - 1];
+        for (size_t j = 1; j < count; j++) {
+            for (size_t i = count - 1; i >= j; i--) {
+                d[i] = (d[i] - d[i - 1]) / (nodes[i] - nodes[i - j]);
+            }
+            last_row[j] = d[count - 1];
+        }
+    }
+
+    void addNode(double z, double fz) {
+        size_t k = nodes.size();
+        last_row.push_back(0.0);
+        // last_row[j] = f[z_{k-j}, ..., z_k]; обход с конца, чтобы читать
+        // разности предыдущей строки до того, как они будут перезаписаны.
+        double current = fz;
+        for (size_t j = 1; j <= k; j++) {
+            double next = (current - last_row[j - 1]) / (z - nodes[k - j]);
+            last_row[j - 1] = current;
+            current = next;
+        }
+        last_row[k] = current;
+        nodes.push_back(z);
+        coefficients.push_back(current);
+    }
+
+    // Значение многочлена степени degree (по первым degree + 1 узлам)
+    // по схеме Горнера.
+    double evaluate(double x, size_t degree) const {
+        double result = coefficients[degree];
+        for (size_t k = degree; k-- > 0;) {
+            result = result * (x - nodes[k]) + coefficients[k];
+        }
+        return result;
+    }
+
+    double evaluate(double x) const {
+        return evaluate(x, nodes.size() - 1);
+    }
+
+    double node(size_t k) const {
+        return nodes[k];
+    }
+
+    const std::vector<double>& getCoefficients() const {
+        return coefficients;
+    }
+
+    size_t size() const {
+        return nodes.size();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+// Интерполяционный кубический сплайн по возрастающим узлам z_0 < ... < z_n.
+// На отрезке [z_i, z_{i+1}]
+//
+//     S(x) = f_i + b_i t + c_i t^2 + d_i t^3,  t = x - z_i,
+//
+// коэффициенты получаются из вторых производных M_i в узлах, которые
+// находятся прогонкой по трёхдиагональной системе за O(n):
+//
+//     h_{i-1} M_{i-1} + 2 (h_{i-1} + h_i) M_i + h_i M_{i+1}
+//         = 6 (f[z_i, z_{i+1}] - f[z_{i-1}, z_i]).
+//
+// Краевые условия: естественные M_0 = M_n = 0 или "not-a-knot" - третья
+// производная непрерывна в z_1 и z_{n-1}. В последнем случае M_0 и M_n
+// выражаются через соседние M и подставляются в первое и последнее
+// уравнения, так что система остаётся трёхдиагональной.
+class CubicSpline {
+public:
+    enum class Boundary { natural, not_a_knot };
+
+private:
+    std::vector<double> nodes;
+    std::vector<double> coefficients; // f_i, b_i, c_i, d_i подряд для каждого отрезка
+    bool uniform = false; // узлы равноотстоящие: отрезок находится по индексу
+    double inverse_step = 0.0;
+
+    size_t intervals() const {
+        return nodes.size() - 1;
+    }
+
+    // Отрезок, содержащий x; точки вне [z_0, z_n] относятся к крайним.
+    size_t locate(double x) const {
+        if (uniform) {
+            double i = std::floor((x - nodes[0]) * inverse_step);
+            return size_t(std::min(std::max(i, 0.0), double(intervals() - 1)));
+        }
+        size_t i = std::upper_bound(nodes.begin() + 1, nodes.end() - 1, x) - nodes.begin();
+        return i - 1;
+    }
+
+public:
+    CubicSpline() {}
+
+    CubicSpline(const std::vector<double>& z, const std::vector<double>& fz, Boundary boundary = Boundary::natural) {
+        setNodes(z, fz, boundary);
+    }
+
+    // Сплайн определён только на отрезке, поэтому узлов нужно не меньше двух
+    void setNodes(const std::vector<double>& z, const std::vector<double>& fz, Boundary boundary = Boundary::natural) {
+        if (z.size() < 2 || fz.size() != z.size()) {
+            throw std::invalid_argument("CubicSpline: нужно не меньше двух узлов и по значению в каждом");
+        }
+        nodes = z;
+        size_t n = z.size() - 1;
+        std::vector<double> h(n), slope(n);
+        for (size_t i = 0; i < n; i++) {
+            h[i] = z[i + 1] - z[i];
+            slope[i] = (fz[i + 1] - fz[i]) / h[i];
+        }
+
+        std::vector<double> moments(n + 1, 0.0);
+        if (boundary == Boundary::not_a_knot && n == 2) {
+            // Три узла: "not-a-knot" сплайн - это парабола через них
+            double second = 2.0 * (slope[1] - slope[0]) / (h[0] + h[1]);
+            std::fill(moments.begin(), moments.end(), second);
+        } else if (n >= 2) {
+            // Прогонка по уравнениям i = 1..n-1 с неизвестными M_1..M_{n-1}:
+            // lower M_{i-1} + diagonal M_i + upper M_{i+1} = right
+            size_t size = n - 1;
+            std::vector<double> lower(size), diagonal(size), upper(size), right(size);
+            for (size_t k = 0; k < size; k++) {
+                size_t i = k + 1;
+                lower[k] = h[i - 1];
+                diagonal[k] = 2.0 * (h[i - 1] + h[i]);
+                upper[k] = h[i];
+                right[k] = 6.0 * (slope[i] - slope[i - 1]);
+            }
+            if (boundary == Boundary::not_a_knot && n >= 3) {
+                // M_0 = ((h_0 + h_1) M_1 - h_0 M_2) / h_1
+                diagonal[0] += h[0] * (h[0] + h[1]) / h[1];
+                upper[0] -= h[0] * h[0] / h[1];
+                // M_n = ((h_{n-2} + h_{n-1}) M_{n-1} - h_{n-1} M_{n-2}) / h_{n-2}
+                diagonal[size - 1] += h[n - 1] * (h[n - 2] + h[n - 1]) / h[n - 2];
+                lower[size - 1] -= h[n - 1] * h[n - 1] / h[n - 2];
+            }
+
+            for (size_t k = 1; k < size; k++) {
+                double factor = lower[k] / diagonal[k - 1];
+                diagonal[k] -= factor * upper[k - 1];
+                right[k] -= factor * right[k - 1];
+            }
+            moments[size] = right[size - 1] / diagonal[size - 1];
+            for (size_t k = size - 1; k-- > 0;) {
+                moments[k + 1] = (right[k] - upper[k] * moments[k + 2]) / diagonal[k];
+            }
+
+            if (boundary == Boundary::not_a_knot && n >= 3) {
+                moments[0] = ((h[0] + h[1]) * moments[1] - h[0] * moments[2]) / h[1];
+                moments[n] = ((h[n - 2] + h[n - 1]) * moments[n - 1] - h[n - 1] * moments[n - 2]) / h[n - 2];
+            }
+        }
+
+        coefficients.resize(4 * n);
+        for (size_t i = 0; i < n; i++) {
+            coefficients[4 * i] = fz[i];
+            coefficients[4 * i + 1] = slope[i] - h[i] * (2.0 * moments[i] + moments[i + 1]) / 6.0;
+            coefficients[4 * i + 2] = moments[i] / 2.0;
+            coefficients[4 * i + 3] = (moments[i + 1] - moments[i]) / (6.0 * h[i]);
+        }
+
+        // Узлы a + i h, вычисленные в double, отстоят от точной сетки на
+        // округление порядка eps |z|, то есть до 1e-10 шага при 10^6 узлах.
+        // Отрезок по индексу для точки у самого узла может тогда оказаться
+        // соседним, но сплайн там продолжается гладко, и ошибка того же
+        // порядка.
+        double step = (z[n] - z[0]) / n;
+        uniform = true;
+        for (size_t i = 0; i <= n && uniform; i++) {
+            uniform = std::abs(z[i] - (z[0] + i * step)) <= 1e-6 * std::abs(step);
+        }
+        inverse_step = 1.0 / step;
+    }
+
+    double evaluate(double x) const {
+        size_t i = locate(x);
+        const double* c = coefficients.data() + 4 * i;
+        double t = x - nodes[i];
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+
+    // Значения в count точках группами по lanes. На равномерной сетке отрезок
+    // находится по индексу, иначе двоичным поиском без ветвлений,
+    // выполняемым по всей группе сразу: обращения к узлам разных точек идут
+    // параллельно, а не ждут друг друга.
+    void evaluate(const double* x, double* result, size_t count) const {
+        const size_t lanes = 8;
+        size_t n = intervals();
+        size_t full = count - count % lanes;
+        for (size_t start = 0; start < full; start += lanes) {
+            size_t index[lanes];
+            if (uniform) {
+                for (size_t l = 0; l < lanes; l++) {
+                    double i = std::floor((x[start + l] - nodes[0]) * inverse_step);
+                    index[l] = size_t(std::min(std::max(i, 0.0), double(n - 1)));
+                }
+            } else {
+                for (size_t l = 0; l < lanes; l++) {
+                    index[l] = 0;
+                }
+                // Наибольший i < n с z_i <= x (или 0)
+                for (size_t length = n; length > 1;) {
+                    size_t half = length / 2;
+                    for (size_t l = 0; l < lanes; l++) {
+                        index[l] = nodes[index[l] + half] <= x[start + l] ? index[l] + half : index[l];
+                    }
+                    length -= half;
+                }
+            }
+            for (size_t l = 0; l < lanes; l++) {
+                const double* c = coefficients.data() + 4 * index[l];
+                double t = x[start + l] - nodes[index[l]];
+                result[start + l] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+            }
+        }
+        for (size_t i = full; i < count; i++) {
+            result[i] = evaluate(x[i]);
+        }
+    }
+
+    void evaluate(const std::vector<double>& x, std::vector<double>& result) const {
+        result.resize(x.size());
+        evaluate(x.data(), result.data(), x.size());
+    }
+
+    bool isUniform() const {
+        return uniform;
+    }
+
+    size_t size() const {
+        return nodes.size();
+    }
+};
\ No newline at end of file
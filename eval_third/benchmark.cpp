@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stencil.hpp"
+#include "finite_difference.hpp"
+#include "table.hpp"
+#include "richardson.hpp"
+
+template <typename Func>
+double time_seconds(Func &&func) {
+  auto start = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// f2(x) = 2x^3 - x^2 + 3x + 1: the O(h^4) formulas are exact for it, so
+// any error is rounding.
+double signal(double x) { return 2.0 * x * x * x - x * x + 3.0 * x + 1.0; }
+double signal_deriv1(double x) { return 6.0 * x * x - 2.0 * x + 3.0; }
+
+// The previous main.cpp: three separate passes, one formula call per point.
+void differentiate_reference(const std::vector<double> &y, double h, Derivatives &out) {
+  int m = static_cast<int>(y.size()) - 1;
+  out.resize(y.size());
+  out.d1_h2[0] = formula4(y.data(), h, 0);
+  for (int k = 1; k < m; k++) {
+    out.d1_h2[k] = formula3(y.data(), h, k);
+  }
+  out.d1_h2[m] = formula5(y.data(), h, m);
+
+  out.d1_h4[0] = formula7(y.data(), h, 0);
+  out.d1_h4[1] = formula8(y.data(), h, 1);
+  for (int k = 2; k <= m - 2; k++) {
+    out.d1_h4[k] = formula9(y.data(), h, k);
+  }
+  out.d1_h4[m - 1] = formula10(y.data(), h, m - 1);
+  out.d1_h4[m] = formula11(y.data(), h, m);
+
+  out.d2_h2[0] = formula12(y.data(), h, 0);
+  for (int k = 1; k < m; k++) {
+    out.d2_h2[k] = formula6(y.data(), h, k);
+  }
+  out.d2_h2[m] = formula13(y.data(), h, m);
+}
+
+void bench_stencil(size_t stream_samples) {
+  const double x0 = 0.0;
+  const size_t size = 10000000;
+  const double h = 1.0 / size;
+  std::vector<double> y(size);
+  for (size_t k = 0; k < size; k++) {
+    y[k] = signal(x0 + k * h);
+  }
+
+  std::cout << "Derivative table, " << size << " samples in memory\n";
+  std::cout << "Time, s    Samples/s    Variant\n";
+  auto report = [](const std::string &name, double time, size_t samples) {
+    std::cout << std::left << std::setw(11) << std::fixed << std::setprecision(4) << time
+              << std::setw(13) << std::scientific << std::setprecision(3) << samples / time
+              << std::defaultfloat << name << "\n";
+  };
+
+  Derivatives reference, fused;
+  differentiate_reference(y, h, reference);
+  differentiate(y, h, fused);
+  report("three passes, formula per point",
+         time_seconds([&]() { differentiate_reference(y, h, reference); }), size);
+  report("fused stencil_interior", time_seconds([&]() { differentiate(y, h, fused); }), size);
+  bool identical = fused.d1_h2 == reference.d1_h2 && fused.d1_h4 == reference.d1_h4 && fused.d2_h2 == reference.d2_h2;
+  std::cout << "Bit-identical to the formulas: " << (identical ? "yes" : "no") << "\n";
+
+  // Same check on a signal whose samples are not exactly representable
+  std::vector<double> wave(100000);
+  for (size_t k = 0; k < wave.size(); k++) {
+    wave[k] = std::sin(1e-3 * k) + 0.5 * std::cos(3.7e-3 * k);
+  }
+  Derivatives wave_reference, wave_fused;
+  differentiate_reference(wave, 1e-3, wave_reference);
+  differentiate(wave, 1e-3, wave_fused);
+  identical = wave_fused.d1_h2 == wave_reference.d1_h2 && wave_fused.d1_h4 == wave_reference.d1_h4 &&
+              wave_fused.d2_h2 == wave_reference.d2_h2;
+  std::cout << "Bit-identical on sin + cos, h = 1e-3: " << (identical ? "yes" : "no") << "\n";
+
+  // Chunks of random length must give exactly the in-memory result
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<size_t> chunk_length(1, 4096);
+  Derivatives streamed;
+  streamed.resize(size);
+  auto collect = [&](size_t first, size_t count, const double *, const double *d1_h2, const double *d1_h4,
+                     const double *d2_h2) {
+    std::copy(d1_h2, d1_h2 + count, streamed.d1_h2.begin() + first);
+    std::copy(d1_h4, d1_h4 + count, streamed.d1_h4.begin() + first);
+    std::copy(d2_h2, d2_h2 + count, streamed.d2_h2.begin() + first);
+  };
+  DerivativeStream<decltype(collect)> check(h, collect);
+  for (size_t k = 0; k < size;) {
+    size_t count = std::min(chunk_length(gen), size - k);
+    check.push(y.data() + k, count);
+    k += count;
+  }
+  check.finish();
+  bool same = streamed.d1_h2 == fused.d1_h2 && streamed.d1_h4 == fused.d1_h4 && streamed.d2_h2 == fused.d2_h2;
+  std::cout << "Stream with random chunks matches differentiate: " << (same ? "yes" : "no") << "\n";
+
+  // Long signal generated chunk by chunk: memory stays at one chunk
+  const size_t chunk = 1 << 16;
+  const double step = 1.0 / stream_samples;
+  std::vector<double> samples(chunk);
+  double max_error = 0.0;
+  auto check_error = [&](size_t first, size_t count, const double *, const double *, const double *d1_h4,
+                         const double *) {
+    for (size_t i = 0; i < count; i++) {
+      max_error = std::max(max_error, std::abs(d1_h4[i] - signal_deriv1(x0 + (first + i) * step)));
+    }
+  };
+  DerivativeStream<decltype(check_error)> stream(step, check_error);
+  double time = time_seconds([&]() {
+    for (size_t k = 0; k < stream_samples; k += chunk) {
+      size_t count = std::min(chunk, stream_samples - k);
+      for (size_t i = 0; i < count; i++) {
+        samples[i] = signal(x0 + (k + i) * step);
+      }
+      stream.push(samples.data(), count);
+    }
+    stream.finish();
+  });
+  std::cout << "\nStreamed " << stream.size() << " samples in chunks of " << chunk << "\n";
+  report("generate + stream + error check", time, stream_samples);
+  std::cout << "Max error of O(h^4) f': " << std::scientific << std::setprecision(2) << max_error
+            << std::defaultfloat << "\n";
+}
+
+// f4(x) = cos(x) - 0.5x^2 + 2 and its derivatives up to the fourth
+double smooth(double x) { return std::cos(x) - 0.5 * x * x + 2.0; }
+double smooth_deriv(int order, double x) {
+  switch (order) {
+    case 1: return -std::sin(x) - x;
+    case 2: return -std::cos(x) - 1.0;
+    case 3: return std::sin(x);
+    default: return std::cos(x);
+  }
+}
+
+// Max error on [0, 4] for two steps, the observed order from their ratio,
+// and the speed on a long table. The steps are large enough that rounding,
+// which grows like eps / h^D, stays below the truncation error.
+template <int D, int P>
+void report_generated(const std::vector<double> &long_y, std::vector<double> &out) {
+  using Kernel = fd::Differentiator<D, P>;
+  double errors[2];
+  double steps[2] = {0.2, 0.1};
+  for (int s = 0; s < 2; s++) {
+    double h = steps[s];
+    size_t size = static_cast<size_t>(4.0 / h + 0.5) + 1;
+    std::vector<double> y(size), d(size);
+    for (size_t k = 0; k < size; k++) {
+      y[k] = smooth(k * h);
+    }
+    Kernel::apply(y.data(), size, h, d.data());
+    errors[s] = 0.0;
+    for (size_t k = 0; k < size; k++) {
+      errors[s] = std::max(errors[s], std::abs(d[k] - smooth_deriv(D, k * h)));
+    }
+  }
+
+  double time = time_seconds([&]() { Kernel::apply(long_y.data(), long_y.size(), 1e-3, out.data()); });
+  std::cout << std::left << std::setw(4) << D << std::setw(4) << P << std::setw(8) << Kernel::Central::points
+            << std::setw(12) << std::scientific << std::setprecision(2) << errors[0] << std::setw(12) << errors[1]
+            << std::setw(10) << std::fixed << std::setprecision(2) << std::log2(errors[0] / errors[1])
+            << std::scientific << std::setprecision(3) << long_y.size() / time << std::defaultfloat << "\n";
+}
+
+void bench_generated() {
+  const size_t size = 10000000;
+  std::vector<double> y(size), out(size);
+  for (size_t k = 0; k < size; k++) {
+    y[k] = smooth(k * 1e-3);
+  }
+
+  std::cout << "Compile-time stencils, error on [0, 4] and speed on " << size << " samples\n";
+  std::cout << "D   P   Points  h = 0.2     h = 0.1     Order     Samples/s\n";
+  report_generated<1, 2>(y, out);
+  report_generated<1, 4>(y, out);
+  report_generated<1, 6>(y, out);
+  report_generated<1, 8>(y, out);
+  report_generated<2, 2>(y, out);
+  report_generated<2, 4>(y, out);
+  report_generated<2, 6>(y, out);
+  report_generated<3, 2>(y, out);
+  report_generated<3, 4>(y, out);
+  report_generated<4, 2>(y, out);
+  report_generated<4, 4>(y, out);
+
+  Derivatives fused;
+  differentiate(y, 1e-3, fused);
+  double time = time_seconds([&]() { differentiate(y, 1e-3, fused); });
+  std::cout << "Hand-written fused pass (three columns): " << std::scientific << std::setprecision(3)
+            << size / time << std::defaultfloat << " samples/s\n";
+}
+
+// Table of f4 with 1, 2, 4, ... threads, at least up to 4 even on fewer
+// cores: points/s for the build and both outputs, and the RMS, which must
+// not depend on the number of threads.
+void bench_table(size_t points) {
+  const FuncDescr &func = FUNCTIONS[3];
+  const double h = 4.0 / (points - 1);
+  size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  const std::string csv = "benchmark_table.csv";
+  const std::string binary = "benchmark_table.bin";
+
+  std::cout << "Derivative table of f4, " << points << " points, " << hardware << " hardware threads\n";
+  std::cout << "Threads  Build, points/s  CSV, points/s  Binary, points/s  RMS of O(h^4) f'\n";
+  DerivativeTable table;
+  build_table(func, 0.0, h, points, table);
+  double first_rms = table.d1_h4_error.rms();
+  bool same = true;
+  for (size_t threads = 1; threads <= std::max<size_t>(hardware, 4); threads *= 2) {
+    double build = time_seconds([&]() { build_table(func, 0.0, h, points, table, threads); });
+    double text = time_seconds([&]() { write_csv(csv, table, threads); });
+    double raw = time_seconds([&]() { write_binary(binary, table); });
+    same = same && table.d1_h4_error.rms() == first_rms;
+    std::cout << std::left << std::setw(9) << threads << std::scientific << std::setprecision(3)
+              << std::setw(17) << points / build << std::setw(15) << points / text << std::setw(18)
+              << points / raw << std::setprecision(6) << table.d1_h4_error.rms() << std::defaultfloat << "\n";
+  }
+  std::remove(csv.c_str());
+  std::remove(binary.c_str());
+  std::cout << "Errors identical for every thread count: " << (same ? "yes" : "no") << "\n";
+}
+
+// Adaptive derivatives on the 11-point table [0, 1], h = 0.1, against fixed
+// steps h / 2^s at the same accuracy: the smallest s whose table meets the
+// tolerance at those 11 points, for f' O(h^4) and f'' O(h^2) separately. A
+// fixed table of step h / 2^s costs 10 * 2^s + 1 values of f. Errors are
+// relative to max(1, |exact|), as in the tableau's stopping test.
+void bench_richardson() {
+  const double h = 0.1;
+  const size_t points = 11;
+  const int max_shift = 16;
+  auto relative = [](double value, double exact) { return std::abs(value - exact) / std::max(1.0, std::abs(exact)); };
+
+  std::cout << "Adaptive Richardson vs fixed step, " << points << " points on [0, 1], h = " << h << "\n";
+  std::cout << "Function  Tolerance  Evals  Error f'   Error f''  Fixed f'  Fixed f''\n";
+  for (int index : {2, 3}) {
+    const FuncDescr &func = FUNCTIONS[index];
+    for (double tolerance : {1e-4, 1e-6, 1e-8, 1e-10}) {
+      std::vector<double> y(points);
+      for (size_t k = 0; k < points; k++) {
+        y[k] = func.f(k * h);
+      }
+      AdaptiveTable adaptive;
+      adaptive_table(func.f, 0.0, h, y, tolerance, 12, adaptive);
+      double error1 = 0.0, error2 = 0.0;
+      for (size_t k = 0; k < points; k++) {
+        error1 = std::max(error1, relative(adaptive.d1[k].value, func.deriv1(k * h)));
+        error2 = std::max(error2, relative(adaptive.d2[k].value, func.deriv2(k * h)));
+      }
+
+      // Fixed step: evaluations needed to reach the tolerance, 0 if never
+      size_t fixed1 = 0, fixed2 = 0;
+      for (int shift = 0; shift <= max_shift && (fixed1 == 0 || fixed2 == 0); shift++) {
+        size_t stride = size_t(1) << shift;
+        size_t size = (points - 1) * stride + 1;
+        double step = h / stride;
+        std::vector<double> fine(size);
+        for (size_t k = 0; k < size; k++) {
+          fine[k] = func.f(k * step);
+        }
+        Derivatives numeric;
+        differentiate(fine, step, numeric);
+        double fixed_error1 = 0.0, fixed_error2 = 0.0;
+        for (size_t k = 0; k < points; k++) {
+          fixed_error1 = std::max(fixed_error1, relative(numeric.d1_h4[k * stride], func.deriv1(k * h)));
+          fixed_error2 = std::max(fixed_error2, relative(numeric.d2_h2[k * stride], func.deriv2(k * h)));
+        }
+        if (fixed1 == 0 && fixed_error1 <= tolerance) {
+          fixed1 = size;
+        }
+        if (fixed2 == 0 && fixed_error2 <= tolerance) {
+          fixed2 = size;
+        }
+      }
+
+      auto fixed = [](size_t evaluations) { return evaluations ? std::to_string(evaluations) : std::string("never"); };
+      std::cout << std::left << std::setw(10) << ("f" + std::to_string(index + 1)) << std::scientific
+                << std::setprecision(0) << std::setw(11) << tolerance << std::setw(7) << points + adaptive.evaluations
+                << std::setprecision(2) << std::setw(11) << error1 << std::setw(11) << error2 << std::setw(10)
+                << fixed(fixed1) << fixed(fixed2) << std::defaultfloat << "\n";
+    }
+  }
+  std::cout << "Evals include the table; fixed tables are searched up to h / 2^" << max_shift << "\n";
+}
+
+int main(int argc, char **argv) {
+  std::string section = argc > 1 ? argv[1] : "all";
+
+  if (section == "all" || section == "stencil") {
+    size_t stream_samples = argc > 2 ? std::stoull(argv[2]) : 100000000;
+    bench_stencil(stream_samples);
+  }
+  if (section == "all" || section == "generated") {
+    bench_generated();
+  }
+  if (section == "all" || section == "table") {
+    size_t points = argc > 2 && section == "table" ? std::stoull(argv[2]) : 10000000;
+    bench_table(points);
+  }
+  if (section == "all" || section == "richardson") {
+    bench_richardson();
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// Finite-difference stencils generated at compile time. Stencil<D, N, First>
+// approximates the D-th derivative at a point from the N samples at offsets
+// First, First + 1, ..., First + N - 1 (in steps of h) around it. It is
+// exact for polynomials of degree N - 1, so the error is O(h^(N - D)), one
+// order better for symmetric stencils with N - D even.
+//
+// The weights come from Fornberg's recurrence evaluated in constexpr, so a
+// stencil of any order is a table of constants baked into the binary, and
+// apply() unrolls into one multiply-add per nonzero weight.
+
+namespace fd {
+
+constexpr double abs(double x) { return x < 0 ? -x : x; }
+
+// Fornberg (1988): weights for derivatives 0..D at 0 on the nodes
+// First..First + N - 1, built up one node at a time. Returns those for D.
+template <int D, int N, int First>
+constexpr std::array<double, N> fornberg_weights() {
+  static_assert(N > D, "a stencil needs more points than the derivative order");
+  std::array<std::array<double, D + 1>, N> c{};
+  double c1 = 1.0;
+  double c4 = First;
+  c[0][0] = 1.0;
+  for (int i = 1; i < N; i++) {
+    int mn = i < D ? i : D;
+    double c2 = 1.0;
+    double c5 = c4;
+    double xi = First + i;
+    c4 = xi;
+    for (int j = 0; j < i; j++) {
+      double c3 = xi - (First + j);
+      c2 *= c3;
+      if (j == i - 1) {
+        for (int k = mn; k > 0; k--) {
+          c[i][k] = c1 * (k * c[i - 1][k - 1] - c5 * c[i - 1][k]) / c2;
+        }
+        c[i][0] = -c1 * c5 * c[i - 1][0] / c2;
+      }
+      for (int k = mn; k > 0; k--) {
+        c[j][k] = (c4 * c[j][k] - k * c[j][k - 1]) / c3;
+      }
+      c[j][0] = c4 * c[j][0] / c3;
+    }
+    c1 = c2;
+  }
+
+  std::array<double, N> weights{};
+  for (int i = 0; i < N; i++) {
+    // Weights that are zero in exact arithmetic (the centre of odd-order
+    // symmetric stencils) come out as rounding noise; drop them.
+    weights[i] = abs(c[i][D]) < 1e-13 ? 0.0 : c[i][D];
+  }
+  return weights;
+}
+
+template <int D, int N, int First>
+struct Stencil {
+  static constexpr int derivative = D;
+  static constexpr int points = N;
+  static constexpr int first = First;
+  static constexpr std::array<double, N> weights = fornberg_weights<D, N, First>();
+
+  // y points at the sample of the evaluation point; scale is 1 / h^D.
+  static double apply(const double *y, double scale) {
+    return sum(y, std::make_integer_sequence<int, N>()) * scale;
+  }
+
+ private:
+  template <int I>
+  static double term(const double *y) {
+    if constexpr (weights[I] == 0.0) {
+      return 0.0;
+    } else {
+      return weights[I] * y[First + I];
+    }
+  }
+
+  template <int... I>
+  static double sum(const double *y, std::integer_sequence<int, I...>) {
+    return (term<I>(y) + ...);
+  }
+};
+
+// Number of points for accuracy O(h^P): one-sided stencils need D + P,
+// symmetric ones get one order for free and use the nearest odd count.
+constexpr int one_sided_points(int D, int P) { return D + P; }
+constexpr int central_points(int D, int P) { return 2 * ((D + 1) / 2) - 1 + P; }
+
+template <int D, int P>
+using ForwardStencil = Stencil<D, one_sided_points(D, P), 0>;
+
+template <int D, int P>
+using BackwardStencil = Stencil<D, one_sided_points(D, P), 1 - one_sided_points(D, P)>;
+
+template <int D, int P>
+using CentralStencil = Stencil<D, central_points(D, P), -(central_points(D, P) - 1) / 2>;
+
+constexpr double power(double h, int n) { return n == 0 ? 1.0 : h * power(h, n - 1); }
+
+// D-th derivative with accuracy O(h^P) at every point of the table
+// y[0..size). Interior points use the central stencil. The R points at each
+// end that it would overrun use one-sided stencils of D + P points, shifted
+// as far inward as the table allows, which is how formulas (7), (8), (10)
+// and (11) are built. Every stencil is a distinct compile-time instance.
+template <int D, int P>
+class Differentiator {
+ public:
+  using Central = CentralStencil<D, P>;
+  static constexpr int radius = (Central::points - 1) / 2;
+  static constexpr int edge_points = one_sided_points(D, P);
+  static constexpr size_t min_size = static_cast<size_t>(edge_points > Central::points ? edge_points : Central::points);
+
+  static void apply(const double *y, size_t size, double h, double *out) {
+    if (size < min_size) {
+      throw std::invalid_argument("Differentiator: table too short for this stencil");
+    }
+    double scale = 1.0 / power(h, D);
+    edges(y, size, scale, out, std::make_integer_sequence<int, radius>());
+    for (size_t k = radius; k + radius < size; k++) {
+      out[k] = Central::apply(y + k, scale);
+    }
+  }
+
+ private:
+  // Point k from the start and point k from the end
+  template <int... K>
+  static void edges(const double *y, size_t size, double scale, double *out, std::integer_sequence<int, K...>) {
+    ((out[K] = Stencil<D, edge_points, -K>::apply(y + K, scale)), ...);
+    ((out[size - 1 - K] = Stencil<D, edge_points, 1 - edge_points + K>::apply(y + size - 1 - K, scale)), ...);
+  }
+};
+
+// The generator reproduces the hand-derived formulas.
+static_assert(abs(ForwardStencil<1, 4>::weights[0] + 25.0 / 12.0) < 1e-14, "formula (7)");
+static_assert(abs(ForwardStencil<1, 4>::weights[4] + 3.0 / 12.0) < 1e-14, "formula (7)");
+static_assert(abs(Stencil<1, 5, -1>::weights[1] + 10.0 / 12.0) < 1e-14, "formula (8)");
+static_assert(CentralStencil<1, 4>::weights[2] == 0.0 && abs(CentralStencil<1, 4>::weights[3] - 8.0 / 12.0) < 1e-14,
+              "formula (9)");
+static_assert(abs(ForwardStencil<2, 2>::weights[1] + 5.0) < 1e-14, "formula (12)");
+static_assert(abs(BackwardStencil<2, 2>::weights[0] + 1.0) < 1e-14, "formula (13)");
+
+}  // namespace fd
\ No newline at end of file
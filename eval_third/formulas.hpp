@@ -0,0 +1,59 @@
+#pragma once
+
+// Finite-difference formulas from the assignment, numbered as in the notes.
+// y points to equally spaced samples y_k = f(x0 + k h).
+
+// (4) - initial point, O(h^2)
+inline double formula4(const double *y, double h, int i) {
+  return (-3.0 * y[i] + 4.0 * y[i+1] - y[i+2]) / (2.0 * h);
+}
+
+// (3) - internal point, O(h^2)
+inline double formula3(const double *y, double h, int i) {
+  return (y[i+1] - y[i-1]) / (2.0 * h);
+}
+
+// (5) - final point, O(h^2)
+inline double formula5(const double *y, double h, int i) {
+  return (3.0 * y[i] - 4.0 * y[i-1] + y[i-2]) / (2.0 * h);
+}
+
+// (7) - initial point, O(h^4)
+inline double formula7(const double *y, double h, int i) {
+  return (-25.0 * y[i] + 48.0 * y[i+1] - 36.0 * y[i+2] + 16.0 * y[i+3] - 3.0 * y[i+4]) / (12.0 * h);
+}
+
+// (8) - second point, O(h^4)
+inline double formula8(const double *y, double h, int i) {
+  return (-3.0 * y[i-1] - 10.0 * y[i] + 18.0 * y[i+1] - 6.0 * y[i+2] + y[i+3]) / (12.0 * h);
+}
+
+// (9) - internal points, O(h^4)
+inline double formula9(const double *y, double h, int i) {
+  return (y[i-2] - 8.0 * y[i-1] + 8.0 * y[i+1] - y[i+2]) / (12.0 * h);
+}
+
+// (10) - prev final point, O(h^4)
+inline double formula10(const double *y, double h, int i) {
+  return (3.0 * y[i+1] + 10.0 * y[i] - 18.0 * y[i-1] + 6.0 * y[i-2] - y[i-3]) / (12.0 * h);
+}
+
+// (11) - final point, O(h^4)
+inline double formula11(const double *y, double h, int i) {
+  return (25.0 * y[i] - 48.0 * y[i-1] + 36.0 * y[i-2] - 16.0 * y[i-3] + 3.0 * y[i-4]) / (12.0 * h);
+}
+
+// (6) - second derivative for internal points, O(h^2)
+inline double formula6(const double *y, double h, int i) {
+  return (y[i+1] - 2.0 * y[i] + y[i-1]) / (h * h);
+}
+
+// (12) - second derivative at initial point, O(h^2)
+inline double formula12(const double *y, double h, int i) {
+  return (2.0 * y[i] - 5.0 * y[i+1] + 4.0 * y[i+2] - y[i+3]) / (h * h);
+}
+
+// (13) - second derivative at final point, O(h^2)
+inline double formula13(const double *y, double h, int i) {
+  return (2.0 * y[i] - 5.0 * y[i-1] + 4.0 * y[i-2] - y[i-3]) / (h * h);
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <string>
+
+// Plain function pointers: the lambdas below capture nothing, and a direct
+// call avoids std::function's type-erased dispatch in the per-point loops.
+using Function = double (*)(double);
+
+struct FuncDescr {
+  Function f;
+  Function deriv1;
+  Function deriv2;
+  std::string name;
+};
+
+inline const std::array<FuncDescr, 4> FUNCTIONS = {{
+  {
+    // f1: Polynomial degree 2
+    [](double x) { return x * x + 3.0 * x - 2.0; },
+    [](double x) { return 2.0 * x + 3.0; },
+    [](double x) { return 2.0; },
+    "f1(x) = x^2 + 3x - 2 (polynomial degree 2)"
+  },
+  {
+    // f2: Polynomial degree 3
+    [](double x) { return 2.0 * x * x * x - x * x + 3.0 * x + 1.0; },
+    [](double x) { return 6.0 * x * x - 2.0 * x + 3.0; },
+    [](double x) { return 12.0 * x - 2.0; },
+    "f2(x) = 2x^3 - x^2 + 3x + 1 (polynomial degree 3)"
+  },
+  {
+    // f3: Fast growing function
+    [](double x) { return std::exp(3.0 * x); },
+    [](double x) { return 3.0 * std::exp(3.0 * x); },
+    [](double x) { return 9.0 * std::exp(3.0 * x); },
+    "f3(x) = e^(3x) (fast growing)"
+  },
+  {
+    // f4: Smooth function
+    [](double x) { return std::cos(x) - 0.5 * x * x + 2.0; },
+    [](double x) { return -std::sin(x) - x; },
+    [](double x) { return -std::cos(x) - 1.0; },
+    "f4(x) = cos(x) - 0.5x^2 + 2 (smooth)"
+  }
+}};
\ No newline at end of file
@@ -3,103 +3,12 @@
 #include <cmath>
 #include <vector>
 #include <string>
-#include <functional>
 #include <array>
+#include <chrono>
 
-using Function = std::function<double(double)>;
-
-struct FuncDescr {
-  Function f;
-  Function deriv1;
-  Function deriv2;
-  std::string name;
-};
-
-const std::array<FuncDescr, 4> FUNCTIONS = {{
-  {
-    // f1: Polynomial degree 2
-    [](double x) { return x * x + 3.0 * x - 2.0; },
-    [](double x) { return 2.0 * x + 3.0; },
-    [](double x) { return 2.0; },
-    "f1(x) = x^2 + 3x - 2 (polynomial degree 2)"
-  },
-  {
-    // f2: Polynomial degree 3
-    [](double x) { return 2.0 * x * x * x - x * x + 3.0 * x + 1.0; },
-    [](double x) { return 6.0 * x * x - 2.0 * x + 3.0; },
-    [](double x) { return 12.0 * x - 2.0; },
-    "f2(x) = 2x^3 - x^2 + 3x + 1 (polynomial degree 3)"
-  },
-  {
-    // f3: Fast growing function
-    [](double x) { return std::exp(3.0 * x); },
-    [](double x) { return 3.0 * std::exp(3.0 * x); },
-    [](double x) { return 9.0 * std::exp(3.0 * x); },
-    "f3(x) = e^(3x) (fast growing)"
-  },
-  {
-    // f4: Smooth function
-    [](double x) { return std::cos(x) - 0.5 * x * x + 2.0; },
-    [](double x) { return -std::sin(x) - x; },
-    [](double x) { return -std::cos(x) - 1.0; },
-    "f4(x) = cos(x) - 0.5x^2 + 2 (smooth)"
-  }
-}};
-
-// (4) - initial point, O(h^2)
-double formula4(const std::vector<double> &y, double h, int i) {
-  return (-3.0 * y[i] + 4.0 * y[i+1] - y[i+2]) / (2.0 * h);
-}
-
-// (3) - internal point, O(h^2)
-double formula3(const std::vector<double> &y, double h, int i) {
-  return (y[i+1] - y[i-1]) / (2.0 * h);
-}
-
-// (5) - final point, O(h^2)
-double formula5(const std::vector<double> &y, double h, int i) {
-  return (3.0 * y[i] - 4.0 * y[i-1] + y[i-2]) / (2.0 * h);
-}
-
-// (7) - initial point, O(h^4)
-double formula7(const std::vector<double> &y, double h, int i) {
-  return (-25.0 * y[i] + 48.0 * y[i+1] - 36.0 * y[i+2] + 16.0 * y[i+3] - 3.0 * y[i+4]) / (12.0 * h);
-}
-
-// (8) - second point, O(h^4)
-double formula8(const std::vector<double> &y, double h, int i) {
-  return (-3.0 * y[i-1] - 10.0 * y[i] + 18.0 * y[i+1] - 6.0 * y[i+2] + y[i+3]) / (12.0 * h);
-}
-
-// (9) - internal points, O(h^4)
-double formula9(const std::vector<double> &y, double h, int i) {
-  return (y[i-2] - 8.0 * y[i-1] + 8.0 * y[i+1] - y[i+2]) / (12.0 * h);
-}
-
-// (10) - prev final point, O(h^4)
-double formula10(const std::vector<double> &y, double h, int i) {
-  return (3.0 * y[i+1] + 10.0 * y[i] - 18.0 * y[i-1] + 6.0 * y[i-2] - y[i-3]) / (12.0 * h);
-}
-
-// (11) - final point, O(h^4)
-double formula11(const std::vector<double> &y, double h, int i) {
-  return (25.0 * y[i] - 48.0 * y[i-1] + 36.0 * y[i-2] - 16.0 * y[i-3] + 3.0 * y[i-4]) / (12.0 * h);
-}
-
-// (6) - second derivative for internal points, O(h^2)
-double formula6(const std::vector<double> &y, double h, int i) {
-  return (y[i+1] - 2.0 * y[i] + y[i-1]) / (h * h);
-}
-
-// (12) - second derivative at initial point, O(h^2)
-double formula12(const std::vector<double> &y, double h, int i) {
-  return (2.0 * y[i] - 5.0 * y[i+1] + 4.0 * y[i+2] - y[i+3]) / (h * h);
-}
-
-// (13) - second derivative at final point, O(h^2)
-double formula13(const std::vector<double> &y, double h, int i) {
-  return (2.0 * y[i] - 5.0 * y[i-1] + 4.0 * y[i-2] - y[i-3]) / (h * h);
-}
+#include "functions.hpp"
+#include "table.hpp"
+#include "richardson.hpp"
 
 int main() {
   char continue_choice;
@@ -152,83 +61,132 @@ int main() {
       precision = std::max(1, std::min(15, precision));
     }
 
-    // Build function value table
-    std::vector<double> x(m + 1);
-    std::vector<double> y(m + 1);
-
-    int col_width = precision + 8;
-
-    std::cout << "\n=== Function Values Table ===\n";
-    std::cout << std::setw(5) << "k" << std::setw(col_width) << "x_k" << std::setw(col_width) << "y_k" << "\n";
-    std::cout << std::string(5 + 2 * col_width, '-') << "\n";
-
-    for (int k = 0; k <= m; k++) {
-      x[k] = x0 + k * h;
-      y[k] = selected_func.f(x[k]);
-      std::cout << std::setw(5) << k << std::setw(col_width) << std::fixed << std::setprecision(precision) << x[k] 
-                << std::setw(col_width) << y[k] << "\n";
+    std::cout << "Output file (.csv or .bin), or - for the screen: ";
+    std::string output;
+    std::cin >> output;
+
+    std::cout << "Tolerance for adaptive f' and f'' by Richardson extrapolation (0 to skip): ";
+    double tolerance;
+    std::cin >> tolerance;
+
+    // Values, exact and numerical derivatives and their errors, computed in
+    // parallel chunks
+    DerivativeTable table;
+    auto build_start = std::chrono::steady_clock::now();
+    build_table(selected_func, x0, h, m + 1, table);
+    double build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+
+    const std::vector<double> &x = table.x;
+    const std::vector<double> &y = table.y;
+    const std::vector<double> &f_prime_exact = table.d1_exact;
+    const std::vector<double> &f_double_prime_exact = table.d2_exact;
+    const std::vector<double> &f_prime_O_h2 = table.numeric.d1_h2;
+    const std::vector<double> &f_prime_O_h4 = table.numeric.d1_h4;
+    const std::vector<double> &f_double_prime_O_h2 = table.numeric.d2_h2;
+
+    // Steps h, h/2, h/4, ... at each table point, reusing the table values
+    AdaptiveTable adaptive;
+    ErrorStats d1_adaptive_error, d2_adaptive_error;
+    if (tolerance > 0) {
+      adaptive_table(selected_func.f, x0, h, y, tolerance, 12, adaptive);
+      for (int k = 0; k <= m; k++) {
+        d1_adaptive_error.add(std::abs(f_prime_exact[k] - adaptive.d1[k].value));
+        d2_adaptive_error.add(std::abs(f_double_prime_exact[k] - adaptive.d2[k].value));
+      }
     }
 
-    // Compute derivatives
-    std::vector<double> f_prime_exact(m + 1);
-    std::vector<double> f_prime_O_h2(m + 1);
-    std::vector<double> f_prime_O_h4(m + 1);
-    std::vector<double> f_double_prime_exact(m + 1);
-    std::vector<double> f_double_prime_O_h2(m + 1);
-
-    // Exact values
-    for (int k = 0; k <= m; k++) {
-      f_prime_exact[k] = selected_func.deriv1(x[k]);
-      f_double_prime_exact[k] = selected_func.deriv2(x[k]);
-    }
-
-    // First derivative O(h^2)
-    f_prime_O_h2[0] = formula4(y, h, 0);
-    for (int k = 1; k < m; k++) {
-      f_prime_O_h2[k] = formula3(y, h, k);
-    }
-    f_prime_O_h2[m] = formula5(y, h, m);
+    int col_width = precision + 8;
 
-    // First derivative O(h^4)
-    f_prime_O_h4[0] = formula7(y, h, 0);
-    f_prime_O_h4[1] = formula8(y, h, 1);
-    for (int k = 2; k <= m - 2; k++) {
-      f_prime_O_h4[k] = formula9(y, h, k);
+    if (output == "-") {
+      std::cout << "\n=== Function Values Table ===\n";
+      std::cout << std::setw(5) << "k" << std::setw(col_width) << "x_k" << std::setw(col_width) << "y_k" << "\n";
+      std::cout << std::string(5 + 2 * col_width, '-') << "\n";
+
+      for (int k = 0; k <= m; k++) {
+        std::cout << std::setw(5) << k << std::setw(col_width) << std::fixed << std::setprecision(precision) << x[k] 
+                  << std::setw(col_width) << y[k] << "\n";
+      }
+
+      // Output results
+      std::cout << "\n=== Numerical Differentiation Results ===\n\n";
+      std::cout << std::setw(col_width) << "x_k" << std::setw(col_width) << "y_k" << std::setw(col_width) << "f'_exact"
+                << std::setw(col_width) << "~f'" << std::setw(col_width) << "error"
+                << std::setw(col_width) << "~~f'" << std::setw(col_width) << "error"
+                << std::setw(col_width) << "f''_exact" << std::setw(col_width) << "~f''" << std::setw(col_width) << "error" << "\n";
+      std::cout << std::setw(col_width) << "" << std::setw(col_width) << "" << std::setw(col_width) << ""
+                << std::setw(col_width) << "O(h^2)" << std::setw(col_width) << "O(h^2)"
+                << std::setw(col_width) << "O(h^4)" << std::setw(col_width) << "O(h^4)"
+                << std::setw(col_width) << "" << std::setw(col_width) << "O(h^2)" << std::setw(col_width) << "O(h^2)" << "\n";
+      std::cout << std::string(10 * col_width, '-') << "\n";
+
+      for (int k = 0; k <= m; k++) {
+        std::cout << std::setw(col_width) << std::setprecision(precision) << x[k]
+                  << std::setw(col_width) << std::setprecision(precision) << y[k]
+                  << std::setw(col_width) << std::setprecision(precision) << f_prime_exact[k]
+                  << std::setw(col_width) << std::setprecision(precision) << f_prime_O_h2[k]
+                  << std::setw(col_width) << std::setprecision(precision) << std::abs(f_prime_exact[k] - f_prime_O_h2[k])
+                  << std::setw(col_width) << std::setprecision(precision) << f_prime_O_h4[k]
+                  << std::setw(col_width) << std::setprecision(precision) << std::abs(f_prime_exact[k] - f_prime_O_h4[k])
+                  << std::setw(col_width) << std::setprecision(precision) << f_double_prime_exact[k]
+                  << std::setw(col_width) << std::setprecision(precision) << f_double_prime_O_h2[k]
+                  << std::setw(col_width) << std::setprecision(precision) << std::abs(f_double_prime_exact[k] - f_double_prime_O_h2[k]) << "\n";
+      }
+
+      if (tolerance > 0) {
+        std::cout << "\n=== Adaptive Derivatives (Richardson) ===\n\n";
+        std::cout << std::setw(col_width) << "x_k" << std::setw(col_width) << "~f'" << std::setw(col_width) << "error"
+                  << std::setw(col_width) << "estimate" << std::setw(col_width) << "~f''" << std::setw(col_width) << "error"
+                  << std::setw(col_width) << "estimate" << std::setw(8) << "levels" << "\n";
+        std::cout << std::string(7 * col_width + 8, '-') << "\n";
+
+        bool all_converged = true;
+        for (int k = 0; k <= m; k++) {
+          const AdaptiveDerivative &d1 = adaptive.d1[k];
+          const AdaptiveDerivative &d2 = adaptive.d2[k];
+          std::cout << std::setw(col_width) << std::setprecision(precision) << x[k]
+                    << std::setw(col_width) << d1.value << std::setw(col_width) << std::abs(f_prime_exact[k] - d1.value)
+                    << std::setw(col_width) << d1.error << std::setw(col_width) << d2.value
+                    << std::setw(col_width) << std::abs(f_double_prime_exact[k] - d2.value)
+                    << std::setw(col_width) << d2.error << std::setw(4) << d1.levels << std::setw(4) << d2.levels
+                    << (d1.converged && d2.converged ? "" : " *") << "\n";
+          all_converged = all_converged && d1.converged && d2.converged;
+        }
+        if (!all_converged) {
+          std::cout << "* tolerance not reached: rounding or the level limit stopped the refinement\n";
+        }
+      }
+    } else {
+      bool binary = output.size() >= 4 && output.compare(output.size() - 4, 4, ".bin") == 0;
+      try {
+        if (binary) {
+          write_binary(output, table);
+        } else {
+          write_csv(output, table);
+        }
+        std::cout << "\nTable written to " << output << (binary ? " (binary, columnar)" : " (CSV)") << "\n";
+      } catch (const std::exception &error) {
+        std::cout << "Error: " << error.what() << "\n";
+      }
     }
-    f_prime_O_h4[m - 1] = formula10(y, h, m - 1);
-    f_prime_O_h4[m] = formula11(y, h, m);
 
-    // Second derivative O(h^2)
-    f_double_prime_O_h2[0] = formula12(y, h, 0);
-    for (int k = 1; k < m; k++) {
-      f_double_prime_O_h2[k] = formula6(y, h, k);
-    }
-    f_double_prime_O_h2[m] = formula13(y, h, m);
-
-    // Output results
-    std::cout << "\n=== Numerical Differentiation Results ===\n\n";
-    std::cout << std::setw(col_width) << "x_k" << std::setw(col_width) << "y_k" << std::setw(col_width) << "f'_exact"
-              << std::setw(col_width) << "~f'" << std::setw(col_width) << "error"
-              << std::setw(col_width) << "~~f'" << std::setw(col_width) << "error"
-              << std::setw(col_width) << "f''_exact" << std::setw(col_width) << "~f''" << std::setw(col_width) << "error" << "\n";
-    std::cout << std::setw(col_width) << "" << std::setw(col_width) << "" << std::setw(col_width) << ""
-              << std::setw(col_width) << "O(h^2)" << std::setw(col_width) << "O(h^2)"
-              << std::setw(col_width) << "O(h^4)" << std::setw(col_width) << "O(h^4)"
-              << std::setw(col_width) << "" << std::setw(col_width) << "O(h^2)" << std::setw(col_width) << "O(h^2)" << "\n";
-    std::cout << std::string(10 * col_width, '-') << "\n";
-
-    for (int k = 0; k <= m; k++) {
-      std::cout << std::setw(col_width) << std::setprecision(precision) << x[k]
-                << std::setw(col_width) << std::setprecision(precision) << y[k]
-                << std::setw(col_width) << std::setprecision(precision) << f_prime_exact[k]
-                << std::setw(col_width) << std::setprecision(precision) << f_prime_O_h2[k]
-                << std::setw(col_width) << std::setprecision(precision) << std::abs(f_prime_exact[k] - f_prime_O_h2[k])
-                << std::setw(col_width) << std::setprecision(precision) << f_prime_O_h4[k]
-                << std::setw(col_width) << std::setprecision(precision) << std::abs(f_prime_exact[k] - f_prime_O_h4[k])
-                << std::setw(col_width) << std::setprecision(precision) << f_double_prime_exact[k]
-                << std::setw(col_width) << std::setprecision(precision) << f_double_prime_O_h2[k]
-                << std::setw(col_width) << std::setprecision(precision) << std::abs(f_double_prime_exact[k] - f_double_prime_O_h2[k]) << "\n";
+    std::cout << "\n=== Error Summary ===\n";
+    std::cout << std::setw(14) << "" << std::setw(14) << "max error" << std::setw(14) << "RMS error" << "\n";
+    auto summary = [](const char *name, const ErrorStats &stats) {
+      std::cout << std::setw(14) << name << std::scientific << std::setprecision(4)
+                << std::setw(14) << stats.max << std::setw(14) << stats.rms() << std::fixed << "\n";
+    };
+    summary("~f'  O(h^2)", table.d1_h2_error);
+    summary("~~f' O(h^4)", table.d1_h4_error);
+    summary("~f'' O(h^2)", table.d2_h2_error);
+    if (tolerance > 0) {
+      summary("f' adaptive", d1_adaptive_error);
+      summary("f'' adaptive", d2_adaptive_error);
+      std::cout << "Function evaluations: " << (m + 1) << " for the table, " << adaptive.evaluations
+                << " more for the adaptive derivatives\n";
     }
+    std::cout << "Built " << (m + 1) << " points in " << std::setprecision(4) << build_seconds << " s ("
+              << std::scientific << std::setprecision(3) << (m + 1) / build_seconds << std::fixed
+              << " points/s)\n";
 
     std::cout << "\nContinue? (y/n): ";
     std::cin >> continue_choice;
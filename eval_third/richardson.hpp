@@ -0,0 +1,144 @@
+#pragma once
+#include "functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Richardson extrapolation of a central difference over the steps h, h/2,
+// h/4, ... Its error expands in even powers, D(h) = D + c1 h^2 + c2 h^4 +
+// ..., so in the Neville tableau
+//
+//   T[k][0] = D(h / 2^k),  T[k][j] = T[k][j-1] + (T[k][j-1] - T[k-1][j-1]) / (4^j - 1)
+//
+// column j has error O(h^(2j+2)). Rounding grows as the step shrinks, so
+// the tableau stops as soon as the best error estimate is within the
+// tolerance or the new diagonal moves away from the previous one by more
+// than twice that estimate: from there on, smaller steps only add noise.
+class RichardsonTableau {
+ public:
+  // The estimate is accepted when error <= tolerance * max(1, |value|).
+  explicit RichardsonTableau(double tolerance) : tolerance_(tolerance) {}
+
+  // Adds D(h / 2^k) for the next k; ignored once done().
+  void add(double estimate) {
+    if (done_) {
+      return;
+    }
+    row_.resize(previous_.size() + 1);
+    row_[0] = estimate;
+    double factor = 4.0;
+    for (size_t j = 1; j < row_.size(); j++) {
+      row_[j] = row_[j - 1] + (row_[j - 1] - previous_[j - 1]) / (factor - 1.0);
+      factor *= 4.0;
+      double error = std::max(std::abs(row_[j] - row_[j - 1]), std::abs(row_[j] - previous_[j - 1]));
+      if (error <= error_) {
+        error_ = error;
+        value_ = row_[j];
+      }
+    }
+    if (row_.size() == 1) {
+      value_ = estimate;
+    } else if (error_ <= tolerance_ * std::max(1.0, std::abs(value_))) {
+      done_ = converged_ = true;
+    } else if (std::abs(row_.back() - previous_.back()) >= 2.0 * error_) {
+      done_ = true;
+    }
+    row_.swap(previous_);
+  }
+
+  bool done() const { return done_; }
+  bool converged() const { return converged_; }
+  double value() const { return value_; }
+  double error() const { return error_; }
+  int levels() const { return static_cast<int>(previous_.size()); }
+
+ private:
+  double tolerance_;
+  std::vector<double> row_;
+  std::vector<double> previous_;
+  double value_ = 0.0;
+  double error_ = std::numeric_limits<double>::infinity();
+  bool done_ = false;
+  bool converged_ = false;
+};
+
+struct AdaptiveDerivative {
+  double value = 0.0;
+  double error = 0.0;  // estimated from the tableau
+  int levels = 0;      // steps h / 2^k used
+  bool converged = false;
+};
+
+// f' and f'' at a point from formulas (3) and (6) with the steps h / 2^k,
+// each extrapolated in its own tableau. Both use the same samples, so a
+// level costs two values of f whichever derivatives still need it.
+// sample(level, side) returns f(x + side * h / 2^level), side = -1 or 1;
+// y0 = f(x).
+template <typename Sample>
+void adaptive_point(double y0, double h, double tolerance, int max_levels, Sample sample,
+                    AdaptiveDerivative &d1, AdaptiveDerivative &d2) {
+  RichardsonTableau first(tolerance), second(tolerance);
+  double step = h;
+  for (int level = 0; level < max_levels && !(first.done() && second.done()); level++) {
+    double left = sample(level, -1);
+    double right = sample(level, 1);
+    first.add((right - left) / (2.0 * step));
+    second.add((right - 2.0 * y0 + left) / (step * step));
+    step /= 2.0;
+  }
+  d1 = {first.value(), first.error(), first.levels(), first.converged()};
+  d2 = {second.value(), second.error(), second.levels(), second.converged()};
+}
+
+struct AdaptiveTable {
+  std::vector<AdaptiveDerivative> d1;
+  std::vector<AdaptiveDerivative> d2;
+  size_t evaluations = 0;  // calls of f beyond the table itself
+};
+
+// Adaptive f' and f'' at every point of the table y_k = f(x0 + k h). No
+// value of f is computed twice: level 0 takes x_k -+ h from the table, and
+// the level 1 sample x_k + h/2 is kept for the next point, where it is
+// x_{k+1} - h/2. Only x0 - h, x_m + h and the deeper levels call f.
+inline void adaptive_table(Function f, double x0, double h, const std::vector<double> &y, double tolerance,
+                           int max_levels, AdaptiveTable &out) {
+  size_t m = y.size() - 1;
+  out.d1.resize(y.size());
+  out.d2.resize(y.size());
+  out.evaluations = 0;
+  auto call = [&](double x) {
+    out.evaluations++;
+    return f(x);
+  };
+
+  double midpoint = 0.0;  // f(x_k - h/2), when the previous point computed it
+  bool have_midpoint = false;
+  for (size_t k = 0; k <= m; k++) {
+    double x = x0 + k * h;
+    bool next_midpoint = false;
+    double next_value = 0.0;
+    auto sample = [&](int level, int side) {
+      if (level == 0) {
+        if (side < 0) {
+          return k > 0 ? y[k - 1] : call(x - h);
+        }
+        return k < m ? y[k + 1] : call(x + h);
+      }
+      if (level == 1 && side < 0 && have_midpoint) {
+        return midpoint;
+      }
+      double value = call(x + side * std::ldexp(h, -level));
+      if (level == 1 && side > 0) {
+        next_midpoint = true;
+        next_value = value;
+      }
+      return value;
+    };
+    adaptive_point(y[k], h, tolerance, max_levels, sample, out.d1[k], out.d2[k]);
+    have_midpoint = next_midpoint;
+    midpoint = next_value;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+#include "formulas.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Derivative columns computed from one table of samples.
+struct Derivatives {
+  std::vector<double> d1_h2;  // f', O(h^2): formulas (4), (3), (5)
+  std::vector<double> d1_h4;  // f', O(h^4): formulas (7)-(11)
+  std::vector<double> d2_h2;  // f'', O(h^2): formulas (12), (6), (13)
+
+  void resize(size_t size) {
+    d1_h2.resize(size);
+    d1_h4.resize(size);
+    d2_h2.resize(size);
+  }
+};
+
+// Interior points k in [begin, end), with y[k-2..k+2] available. One fused
+// pass computes all three columns from the same five loads: formulas (3),
+// (9) and (6), with the same divisions, so the results equal theirs bit
+// for bit. The loop has no branches, so the compiler vectorizes it.
+inline void stencil_interior(const double *y, double h, size_t begin, size_t end,
+                             double *d1_h2, double *d1_h4, double *d2_h2) {
+  const double c2 = 2.0 * h;
+  const double c4 = 12.0 * h;
+  const double s2 = h * h;
+  for (size_t k = begin; k < end; k++) {
+    double ym2 = y[k - 2], ym1 = y[k - 1], y0 = y[k], yp1 = y[k + 1], yp2 = y[k + 2];
+    d1_h2[k] = (yp1 - ym1) / c2;
+    d1_h4[k] = (ym2 - 8.0 * ym1 + 8.0 * yp1 - yp2) / c4;
+    d2_h2[k] = (yp1 - 2.0 * y0 + ym1) / s2;
+  }
+}
+
+// Points 0 and 1, which need y[0..4].
+inline void stencil_start(const double *y, double h, double *d1_h2, double *d1_h4, double *d2_h2) {
+  d1_h2[0] = formula4(y, h, 0);
+  d1_h2[1] = formula3(y, h, 1);
+  d1_h4[0] = formula7(y, h, 0);
+  d1_h4[1] = formula8(y, h, 1);
+  d2_h2[0] = formula12(y, h, 0);
+  d2_h2[1] = formula6(y, h, 1);
+}
+
+// Points m - 1 and m, which need y[m-4..m].
+inline void stencil_end(const double *y, double h, size_t m, double *d1_h2, double *d1_h4, double *d2_h2) {
+  int i = static_cast<int>(m);
+  d1_h2[m - 1] = formula3(y, h, i - 1);
+  d1_h2[m] = formula5(y, h, i);
+  d1_h4[m - 1] = formula10(y, h, i - 1);
+  d1_h4[m] = formula11(y, h, i);
+  d2_h2[m - 1] = formula6(y, h, i - 1);
+  d2_h2[m] = formula13(y, h, i);
+}
+
+// All derivatives for a whole table y_0..y_m, m >= 4.
+inline void differentiate(const std::vector<double> &y, double h, Derivatives &out) {
+  if (y.size() < 5) {
+    throw std::invalid_argument("differentiate: need at least 5 points");
+  }
+  size_t m = y.size() - 1;
+  out.resize(y.size());
+  stencil_start(y.data(), h, out.d1_h2.data(), out.d1_h4.data(), out.d2_h2.data());
+  stencil_interior(y.data(), h, 2, m - 1, out.d1_h2.data(), out.d1_h4.data(), out.d2_h2.data());
+  stencil_end(y.data(), h, m, out.d1_h2.data(), out.d1_h4.data(), out.d2_h2.data());
+}
+
+// Same result for a signal that arrives in chunks of any size, so the whole
+// signal never has to be in memory. Only the last few samples are kept
+// between chunks as a halo: interior stencils reach two samples back, and
+// formula (11) at the last point reaches four. The last two points are held
+// back until finish(), since only then is it known that they need the
+// end formulas.
+//
+// Results go to sink(first, count, y, d1_h2, d1_h4, d2_h2): count points
+// starting at global index first, with the arrays indexed from 0.
+template <typename Sink>
+class DerivativeStream {
+ public:
+  DerivativeStream(double h, Sink sink) : h_(h), sink_(sink) {}
+
+  void push(const double *chunk, size_t count) {
+    buffer_.insert(buffer_.end(), chunk, chunk + count);
+    total_ += count;
+    if (total_ >= 5) {
+      emit(total_ - 2, false);
+    }
+  }
+
+  void finish() {
+    if (total_ < 5) {
+      throw std::invalid_argument("DerivativeStream: need at least 5 points");
+    }
+    emit(total_, true);
+  }
+
+  size_t size() const { return total_; }
+
+ private:
+  // Samples kept before the first held-back point m - 1: formula (11) at
+  // m reaches back to m - 4.
+  static constexpr size_t halo = 3;
+
+  // Points [emitted_, end) in global numbering. The buffer holds samples
+  // from global index base_.
+  void emit(size_t end, bool last) {
+    if (end <= emitted_) {
+      return;
+    }
+    out_.resize(buffer_.size());
+    const double *y = buffer_.data();
+    double *d1_h2 = out_.d1_h2.data(), *d1_h4 = out_.d1_h4.data(), *d2_h2 = out_.d2_h2.data();
+    size_t begin = emitted_ - base_;
+    size_t stop = end - base_;
+
+    if (emitted_ == 0) {
+      stencil_start(y, h_, d1_h2, d1_h4, d2_h2);
+    }
+    size_t interior_end = last ? stop - 2 : stop;
+    size_t interior_begin = emitted_ == 0 ? 2 : begin;
+    if (interior_end > interior_begin) {
+      stencil_interior(y, h_, interior_begin, interior_end, d1_h2, d1_h4, d2_h2);
+    }
+    if (last) {
+      stencil_end(y, h_, stop - 1, d1_h2, d1_h4, d2_h2);
+    }
+    sink_(emitted_, end - emitted_, y + begin, d1_h2 + begin, d1_h4 + begin, d2_h2 + begin);
+    emitted_ = end;
+
+    // Keep the halo and the held-back points
+    size_t keep_from = emitted_ > halo ? emitted_ - halo : 0;
+    if (keep_from > base_) {
+      buffer_.erase(buffer_.begin(), buffer_.begin() + (keep_from - base_));
+      base_ = keep_from;
+    }
+  }
+
+  double h_;
+  Sink sink_;
+  std::vector<double> buffer_;
+  Derivatives out_;
+  size_t base_ = 0;     // global index of buffer_[0]
+  size_t emitted_ = 0;  // points already passed to the sink
+  size_t total_ = 0;    // samples received
+};
\ No newline at end of file
@@ -0,0 +1,210 @@
+#pragma once
+#include "functions.hpp"
+#include "stencil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Calls body(begin, end) on consecutive ranges of [0, count), at most chunk
+// long. Threads take ranges from a shared counter, so uneven ranges still
+// balance. threads = 0 means std::thread::hardware_concurrency().
+template <typename Body>
+void parallel_chunks(size_t count, size_t chunk, Body body, size_t threads = 0) {
+  if (threads == 0) {
+    threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  size_t chunks = (count + chunk - 1) / chunk;
+  threads = std::max<size_t>(std::min(threads, chunks), 1);
+
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t c = next++; c < chunks; c = next++) {
+      body(c * chunk, std::min(count, (c + 1) * chunk));
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+// Error of one numerical derivative against the exact one.
+struct ErrorStats {
+  double max = 0.0;
+  double sum_squares = 0.0;
+  size_t count = 0;
+
+  void add(double error) {
+    max = std::max(max, error);
+    sum_squares += error * error;
+    count++;
+  }
+
+  void merge(const ErrorStats &other) {
+    max = std::max(max, other.max);
+    sum_squares += other.sum_squares;
+    count += other.count;
+  }
+
+  double rms() const { return count > 0 ? std::sqrt(sum_squares / count) : 0.0; }
+};
+
+// Table x_k = x0 + k h, k = 0..m, with exact and numerical derivatives.
+struct DerivativeTable {
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> d1_exact;
+  std::vector<double> d2_exact;
+  Derivatives numeric;
+  ErrorStats d1_h2_error;
+  ErrorStats d1_h4_error;
+  ErrorStats d2_h2_error;
+
+  size_t size() const { return x.size(); }
+};
+
+// Builds the table in two parallel passes over chunks of points:
+// 1) x, y and the exact derivatives;
+// 2) the stencils, which need neighbouring y from pass 1, fused with the
+//    error reduction.
+// Each chunk reduces its own errors into a slot of its own, and the slots
+// are merged in chunk order afterwards. The RMS is therefore the same for
+// any number of threads.
+inline void build_table(const FuncDescr &func, double x0, double h, size_t points, DerivativeTable &table,
+                        size_t threads = 0, size_t chunk = 1 << 15) {
+  if (points < 5) {
+    throw std::invalid_argument("build_table: need at least 5 points");
+  }
+  table.x.resize(points);
+  table.y.resize(points);
+  table.d1_exact.resize(points);
+  table.d2_exact.resize(points);
+  table.numeric.resize(points);
+
+  parallel_chunks(points, chunk, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+      double x = x0 + k * h;
+      table.x[k] = x;
+      table.y[k] = func.f(x);
+      table.d1_exact[k] = func.deriv1(x);
+      table.d2_exact[k] = func.deriv2(x);
+    }
+  }, threads);
+
+  const double *y = table.y.data();
+  double *d1_h2 = table.numeric.d1_h2.data();
+  double *d1_h4 = table.numeric.d1_h4.data();
+  double *d2_h2 = table.numeric.d2_h2.data();
+  size_t m = points - 1;
+  size_t chunks = (points + chunk - 1) / chunk;
+  std::vector<std::array<ErrorStats, 3>> partial(chunks);
+
+  // The four edge points are done first: a chunk boundary may fall between
+  // m - 1 and m, and each chunk must only read values it wrote itself.
+  stencil_start(y, h, d1_h2, d1_h4, d2_h2);
+  stencil_end(y, h, m, d1_h2, d1_h4, d2_h2);
+
+  parallel_chunks(points, chunk, [&](size_t begin, size_t end) {
+    stencil_interior(y, h, std::max<size_t>(begin, 2), std::min(end, m - 1), d1_h2, d1_h4, d2_h2);
+
+    auto &errors = partial[begin / chunk];
+    for (size_t k = begin; k < end; k++) {
+      errors[0].add(std::abs(table.d1_exact[k] - d1_h2[k]));
+      errors[1].add(std::abs(table.d1_exact[k] - d1_h4[k]));
+      errors[2].add(std::abs(table.d2_exact[k] - d2_h2[k]));
+    }
+  }, threads);
+
+  table.d1_h2_error = table.d1_h4_error = table.d2_h2_error = ErrorStats();
+  for (const auto &errors : partial) {
+    table.d1_h2_error.merge(errors[0]);
+    table.d1_h4_error.merge(errors[1]);
+    table.d2_h2_error.merge(errors[2]);
+  }
+}
+
+// Column order of the CSV and binary outputs
+inline const std::array<const char *, 7> TABLE_COLUMNS = {
+  {"x", "y", "d1_exact", "d1_h2", "d1_h4", "d2_exact", "d2_h2"}};
+
+inline std::array<const double *, 7> table_columns(const DerivativeTable &table) {
+  return {{table.x.data(), table.y.data(), table.d1_exact.data(), table.numeric.d1_h2.data(),
+           table.numeric.d1_h4.data(), table.d2_exact.data(), table.numeric.d2_h2.data()}};
+}
+
+// CSV with a header line. Numbers are the shortest decimal that reads
+// back to the same double (std::to_chars), several times faster than
+// printf with 17 digits. Rows are formatted in parallel chunks and written in order.
+inline void write_csv(const std::string &path, const DerivativeTable &table, size_t threads = 0,
+                      size_t chunk = 1 << 14) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  for (size_t c = 0; c < TABLE_COLUMNS.size(); c++) {
+    out << TABLE_COLUMNS[c] << (c + 1 < TABLE_COLUMNS.size() ? "," : "\n");
+  }
+
+  auto columns = table_columns(table);
+  size_t rows = table.size();
+  size_t chunks = (rows + chunk - 1) / chunk;
+  // Formatted text for a batch of chunks at a time bounds the memory held
+  size_t batch = std::max<size_t>(std::thread::hardware_concurrency(), 1) * 4;
+  std::vector<std::string> text(std::min(batch, chunks));
+  for (size_t first = 0; first < chunks; first += batch) {
+    size_t last = std::min(chunks, first + batch);
+    parallel_chunks(last - first, 1, [&](size_t begin, size_t) {
+      std::string &buffer = text[begin];
+      buffer.clear();
+      char number[32];
+      size_t row_end = std::min(rows, (first + begin + 1) * chunk);
+      for (size_t k = (first + begin) * chunk; k < row_end; k++) {
+        for (size_t c = 0; c < columns.size(); c++) {
+          char *end = std::to_chars(number, number + sizeof(number), columns[c][k]).ptr;
+          buffer.append(number, end);
+          buffer.push_back(c + 1 < columns.size() ? ',' : '\n');
+        }
+      }
+    }, threads);
+    for (size_t c = 0; c < last - first; c++) {
+      out.write(text[c].data(), text[c].size());
+    }
+  }
+  if (!out) {
+    throw std::runtime_error("write to " + path + " failed");
+  }
+}
+
+// Columnar binary: the 8-byte tag "DIFFTAB1", the row and column counts as
+// uint64, then each column as rows native doubles in TABLE_COLUMNS order.
+inline void write_binary(const std::string &path, const DerivativeTable &table) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  std::uint64_t rows = table.size();
+  std::uint64_t column_count = TABLE_COLUMNS.size();
+  out.write("DIFFTAB1", 8);
+  out.write(reinterpret_cast<const char *>(&rows), sizeof(rows));
+  out.write(reinterpret_cast<const char *>(&column_count), sizeof(column_count));
+  for (const double *column : table_columns(table)) {
+    out.write(reinterpret_cast<const char *>(column), rows * sizeof(double));
+  }
+  if (!out) {
+    throw std::runtime_error("write to " + path + " failed");
+  }
+}
\ No newline at end of file
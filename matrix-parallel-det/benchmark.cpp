@@ -0,0 +1,611 @@
+#include "determine.hpp"
+#include "matrix_io.hpp"
+#include "generators.hpp"
+#include "determinant_tracker.hpp"
+
+#include <chrono>
+#include <print>
+#include <random>
+#include <string_view>
+#include <filesystem>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <functional>
+#include <limits>
+
+template <typename F>
+static double time_seconds(F &&func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static std::vector<std::size_t> thread_counts() {
+  std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::size_t> counts;
+  for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+  return counts;
+}
+
+static void bench_det_high_scaling() {
+  std::size_t max_threads = thread_counts().back();
+
+  std::println("det_high scaling (hardware threads: {})", max_threads);
+  std::println("{:>4} {:>8} {:>12} {:>8}", "n", "threads", "time, s", "speedup");
+  for (std::size_t n = 9; n <= 12; n++) {
+    auto matrix = random_matrix(n, n);
+    double serial_time = 0;
+
+    for (auto threads : thread_counts()) {
+      max_number_of_threads = threads;
+      float result;
+      auto run = [&]() {
+        det_high(matrix, result);
+      };
+      time_seconds(run);  // warm up the pool
+      auto time = time_seconds(run);
+      if (threads == 1) {
+        serial_time = time;
+      }
+      std::println("{:>4} {:>8} {:>12.6f} {:>8.2f}", n, threads, time, serial_time / time);
+    }
+  }
+}
+
+static std::string_view level_name(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::avx512:
+    return "avx512";
+  case SimdLevel::avx2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
+
+template <typename T>
+static void bench_det_gauss_type(const Matrix &matrix, std::string_view type_name) {
+  double n = matrix.size();
+  double flops = 2.0 / 3.0 * n * n * n;
+  double bytes = 2.0 / 3.0 * n * n * n * sizeof(T);  // every update reads and writes a trailing element
+
+  for (auto level : {SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512}) {
+    if (level > detected_simd_level()) {
+      continue;
+    }
+    set_simd_level(level);
+
+    volatile T det;
+    double time = time_seconds([&]() {
+      det = det_gauss<T>(matrix);
+    });
+    (void)det;
+
+    std::println("{:>6} {:>7} {:>7} {:>10.4f} {:>9.2f} {:>9.2f}", matrix.size(), type_name, level_name(level),
+                 time, flops / time * 1e-9, bytes / time * 1e-9);
+  }
+  set_simd_level(detected_simd_level());
+}
+
+static void bench_det_gauss() {
+  std::println("det_gauss elimination kernels");
+  std::println("{:>6} {:>7} {:>7} {:>10} {:>9} {:>9}", "n", "type", "simd", "time, s", "GFLOP/s", "GB/s");
+  for (std::size_t n : {500, 1000, 2000}) {
+    auto matrix = random_matrix(n, n);
+    bench_det_gauss_type<float>(matrix, "float");
+    bench_det_gauss_type<double>(matrix, "double");
+  }
+}
+
+static double lu_gflops(std::size_t n, double time) {
+  return 2.0 / 3.0 * n * n * n / time * 1e-9;
+}
+
+static void bench_det_blocked() {
+  std::println("det_blocked LU (block size {})", det_block_size);
+  std::println("{:>6} {:>12} {:>8} {:>10} {:>9} {:>8}", "n", "engine", "threads", "time, s", "GFLOP/s", "speedup");
+  for (std::size_t n : {512, 1024, 2048, 4096}) {
+    auto matrix = random_matrix(n, n);
+
+    auto gauss = time_seconds([&]() {
+      volatile float det = det_gauss<float>(matrix);
+      (void)det;
+    });
+    std::println("{:>6} {:>12} {:>8} {:>10.4f} {:>9.2f} {:>8}", n, "det_gauss", 1, gauss, lu_gflops(n, gauss), "");
+
+    double serial = 0;
+    for (auto threads : thread_counts()) {
+      auto time = time_seconds([&]() {
+        volatile float det = det_blocked<float>(matrix, det_block_size, threads);
+        (void)det;
+      });
+      if (threads == 1) {
+        serial = time;
+      }
+      std::println("{:>6} {:>12} {:>8} {:>10.4f} {:>9.2f} {:>8.2f}", n, "det_blocked", threads, time, lu_gflops(n, time), serial / time);
+    }
+  }
+
+  std::println("det_blocked block size sweep, n = 2048, 1 thread");
+  std::println("{:>6} {:>10} {:>9}", "block", "time, s", "GFLOP/s");
+  auto matrix = random_matrix(2048, 2048);
+  for (std::size_t block_size : {16, 32, 64, 128, 256}) {
+    auto time = time_seconds([&]() {
+      volatile float det = det_blocked<float>(matrix, block_size, 1);
+      (void)det;
+    });
+    std::println("{:>6} {:>10.4f} {:>9.2f}", block_size, time, lu_gflops(2048, time));
+  }
+}
+
+static std::string relative_error(double value, double reference) {
+  if (!std::isfinite(value) || !std::isfinite(reference)) {
+    return "overflow";
+  }
+  std::ostringstream out;
+  out << std::scientific << std::setprecision(3) << std::fabs((value - reference) / reference);
+  return out.str();
+}
+
+static void bench_det_exact() {
+  std::println("det_exact (Bareiss) vs floating point, entries in [0, 100]");
+  std::println("{:>5} {:>16} {:>10} {:>12} {:>7}", "n", "engine", "time, s", "rel. error", "digits");
+  for (std::size_t n : {10, 50, 100, 200, 500}) {
+    auto matrix = data_like_matrix(n, n);
+
+    BigInteger exact;
+    auto exact_time = time_seconds([&]() {
+      exact = det_exact(matrix);
+    });
+    double reference = exact.to_double();
+    std::println("{:>5} {:>16} {:>10.4f} {:>12} {:>7}", n, "det_exact", exact_time, 0, exact.to_string().size());
+
+    float det_f = 0;
+    auto float_time = time_seconds([&]() {
+      det_f = det_gauss<float>(matrix);
+    });
+    std::println("{:>5} {:>16} {:>10.4f} {:>12}", n, "det_gauss<float>", float_time, relative_error(det_f, reference));
+
+    double det_d = 0;
+    auto double_time = time_seconds([&]() {
+      det_d = det_gauss<double>(matrix);
+    });
+    std::println("{:>5} {:>16} {:>10.4f} {:>12}", n, "det_gauss<double>", double_time, relative_error(det_d, reference));
+  }
+}
+
+static void bench_det_batch() {
+  const std::size_t count = 1'000'000;
+  // det_low spawns threads on every call, so it only gets a sample.
+  const std::size_t det_low_count = 10'000;
+
+  std::vector<Matrix> matrices;
+  matrices.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    matrices.push_back(random_matrix(4, i));
+  }
+  std::vector<float> results(count);
+
+  max_number_of_threads = thread_counts().back();
+  std::println("det_batch: 1M 4x4 matrices, {} threads", max_number_of_threads);
+  std::println("{:>12} {:>14}", "engine", "ns / matrix");
+
+  // Nanoseconds per matrix.
+  auto low = time_seconds([&]() {
+    for (std::size_t i = 0; i < det_low_count; i++) {
+      results[i] = det_low(matrices[i]);
+    }
+  }) / det_low_count * 1e9;
+  std::println("{:>12} {:>14.1f}", "det_low", low);
+
+  auto gauss = time_seconds([&]() {
+    for (std::size_t i = 0; i < count; i++) {
+      results[i] = det_gauss<float>(matrices[i]);
+    }
+  }) / count * 1e9;
+  std::println("{:>12} {:>14.1f}", "det_gauss", gauss);
+
+  auto batch = time_seconds([&]() {
+    det_batch(matrices, results);
+  }) / count * 1e9;
+  std::println("{:>12} {:>14.1f}", "det_batch", batch);
+}
+
+// The loader main.cpp used before the from_chars parser, kept as a baseline.
+static Matrix load_with_ifstream(const std::string &file_name) {
+  std::ifstream file(file_name);
+  int rows, cols;
+  file >> rows >> cols;
+
+  auto matrix = Matrix::zeros(rows);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      file >> matrix(i, j);
+    }
+  }
+  return matrix;
+}
+
+template <typename F>
+static void bench_load(std::string_view name, const std::string &file_name, F &&load) {
+  double bytes = std::filesystem::file_size(file_name);
+
+  double checksum = 0;
+  double time = time_seconds([&]() {
+    auto matrix = load(file_name);
+    // Touch every element so the mapped loader pays for its page faults.
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+      for (auto value : matrix.row(i)) {
+        checksum += value;
+      }
+    }
+  });
+
+  std::println("{:>10} {:>10.1f} {:>10.4f} {:>8.3f}  (checksum {})", name, bytes / 1e6, time, bytes / time * 1e-9, checksum);
+}
+
+static void bench_loading() {
+  const std::size_t n = 4000;
+  auto directory = std::filesystem::temp_directory_path();
+  auto text_name = (directory / "det_bench_matrix.txt").string();
+  auto binary_name = (directory / "det_bench_matrix.bin").string();
+
+  auto matrix = random_matrix(n, 1);
+  {
+    std::ofstream file(text_name);
+    file << n << ' ' << n << '\n';
+    for (std::size_t i = 0; i < n; i++) {
+      for (auto value : matrix.row(i)) {
+        file << value << ' ';
+      }
+      file << '\n';
+    }
+  }
+  save_matrix_binary(matrix, binary_name);
+
+  std::println("matrix loading, {}x{}", n, n);
+  std::println("{:>10} {:>10} {:>10} {:>8}", "loader", "MB", "time, s", "GB/s");
+  bench_load("ifstream", text_name, load_with_ifstream);
+  bench_load("from_chars", text_name, load_matrix_text);
+  bench_load("mmap", binary_name, load_matrix_binary);
+
+  std::filesystem::remove(text_name);
+  std::filesystem::remove(binary_name);
+}
+
+// One engine of the suite. `run` gets the matrix and a thread count and
+// returns the determinant as double; engines without a thread knob ignore it.
+struct Engine {
+  std::string_view name;
+  std::size_t max_size;
+  bool threaded;
+  std::function<double(const Matrix &, std::size_t)> run;
+};
+
+static const std::vector<Engine> &engines() {
+  static const std::vector<Engine> all = {
+    {"det_low", 10, true, [](const Matrix &m, std::size_t threads) {
+      return double(det_low(m, threads));
+    }},
+    {"det_high", 10, true, [](const Matrix &m, std::size_t threads) {
+      max_number_of_threads = threads;
+      float result;
+      det_high(m, result);
+      return double(result);
+    }},
+    {"det_batch", 8, false, [](const Matrix &m, std::size_t) {
+      float result;
+      det_batch(std::span(&m, 1), std::span(&result, 1));
+      return double(result);
+    }},
+    {"det_gauss<float>", SIZE_MAX, false, [](const Matrix &m, std::size_t) {
+      return double(det_gauss<float>(m));
+    }},
+    {"det_gauss<double>", SIZE_MAX, false, [](const Matrix &m, std::size_t) {
+      return det_gauss<double>(m);
+    }},
+    {"det_blocked<float>", SIZE_MAX, true, [](const Matrix &m, std::size_t threads) {
+      return double(det_blocked<float>(m, det_block_size, threads));
+    }},
+    {"det_blocked<double>", SIZE_MAX, true, [](const Matrix &m, std::size_t threads) {
+      return det_blocked<double>(m, det_block_size, threads);
+    }},
+    // Includes the conversion to compressed columns, as det_auto pays it too.
+    {"det_sparse", SIZE_MAX, false, [](const Matrix &m, std::size_t) {
+      return det_sparse(SparseMatrix::from_dense(m)).value();
+    }},
+    {"det_auto", SIZE_MAX, false, [](const Matrix &m, std::size_t) {
+      return det_auto(m);
+    }},
+  };
+  return all;
+}
+
+struct Workload {
+  std::string_view name;
+  std::function<Matrix(std::size_t)> generate;
+};
+
+static const std::vector<Workload> &workloads() {
+  static const std::vector<Workload> all = {
+    {"random", [](std::size_t n) {
+      return random_matrix(n, n);
+    }},
+    {"sparse", [](std::size_t n) {
+      return sparse_matrix(n, std::min(1.0, 4.0 / n), n);
+    }},
+    {"banded", [](std::size_t n) {
+      return banded_matrix(n, 3, n);
+    }},
+    {"ill_conditioned", [](std::size_t n) {
+      return ill_conditioned_matrix(n, n);
+    }},
+  };
+  return all;
+}
+
+// Best of several runs, repeated until `min_total` seconds have passed so
+// that microsecond-scale engines are not dominated by timer noise.
+static double best_time(const std::function<void()> &func, double min_total = 0.05) {
+  double best = std::numeric_limits<double>::infinity();
+  double total = 0;
+  do {
+    double time = time_seconds(func);
+    best = std::min(best, time);
+    total += time;
+  } while (total < min_total);
+  return best;
+}
+
+// Rescales rows by powers of two so that |det| is close to 1 and the float
+// engines neither overflow nor underflow. Entries stay exact, and
+// det(result) = det(matrix) * 2^exponent.
+static Matrix normalize_determinant(const Matrix &matrix, int &exponent) {
+  std::size_t n = matrix.size();
+  std::vector<int> shifts(n);
+  auto scaled = matrix;
+
+  auto apply = [&]() {
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        scaled(i, j) = std::ldexp(matrix(i, j), shifts[i]);
+      }
+    }
+  };
+
+  // Rows of norm within [1/sqrt(2), sqrt(2)] first: Hadamard's inequality
+  // bounds |det| by 2^(n/2) then, and a random matrix lands near e^(-n/2),
+  // so the double estimate below stays in range for the benchmarked sizes.
+  for (std::size_t i = 0; i < n; i++) {
+    double norm = 0;
+    for (auto value : matrix.row(i)) {
+      norm += double(value) * value;
+    }
+    shifts[i] = norm == 0 ? 0 : -int(std::lround(std::log2(std::sqrt(norm))));
+  }
+  apply();
+
+  double det = det_gauss<double>(scaled);
+  if (det != 0 && std::isfinite(std::log2(std::fabs(det)))) {
+    long total = -std::lround(std::log2(std::fabs(det)));
+    for (std::size_t i = 0; i < n; i++) {
+      shifts[i] += total / long(n) + (long(i) < total % long(n) ? 1 : 0);
+    }
+    apply();
+  }
+
+  exponent = 0;
+  for (auto shift : shifts) {
+    exponent += shift;
+  }
+  return scaled;
+}
+
+static void bench_det_sparse() {
+  std::println("det_sparse vs det_blocked<double>, n = 1024, by density (rows rescaled as in the suite)");
+  std::println("{:>8} {:>12} {:>12} {:>10} {:>10}", "density", "sparse, s", "dense, s", "fill", "rel_error");
+  for (double density : {0.002, 0.005, 0.01, 0.02, 0.05, 0.1}) {
+    int exponent;
+    auto matrix = normalize_determinant(sparse_matrix(1024, density, 1), exponent);
+    auto sparse = SparseMatrix::from_dense(matrix);
+    SparseDeterminant result;
+    auto sparse_time = time_seconds([&]() {
+      result = det_sparse(sparse);
+    });
+    double dense = 0;
+    auto dense_time = time_seconds([&]() {
+      dense = det_blocked<double>(matrix);
+    });
+    std::println("{:>8} {:>12.5f} {:>12.5f} {:>10} {:>10}", density, sparse_time, dense_time,
+                 result.factor_nonzeros, relative_error(result.value(), dense));
+  }
+
+  std::println("det_sparse on large matrices (L nonzeros as fill)");
+  std::println("{:>16} {:>8} {:>10} {:>10} {:>12} {:>14}", "workload", "n", "nnz(A)", "fill", "time, s", "log10|det|");
+  auto report = [](std::string_view name, const SparseMatrix &matrix) {
+    SparseDeterminant result;
+    auto time = time_seconds([&]() {
+      result = det_sparse(matrix);
+    });
+    std::println("{:>16} {:>8} {:>10} {:>10} {:>12.5f} {:>14.4f}", name, matrix.size(), matrix.nonzeros(),
+                 result.factor_nonzeros, time, result.log10_abs());
+    return time;
+  };
+  for (std::size_t n : {1000, 10000, 100000}) {
+    report("banded(2)", banded_sparse_matrix(n, 2, 1));
+    report("banded(8)", banded_sparse_matrix(n, 8, 1));
+  }
+  // Random sparse patterns have no small separators, so fill grows
+  // roughly quadratically whatever the ordering; stop once a size takes
+  // too long.
+  for (std::size_t n : {1000, 2000, 5000, 10000, 20000, 50000, 100000}) {
+    if (report("random(2/row)", random_sparse_matrix(n, 2, 1)) > 2) {
+      break;
+    }
+  }
+}
+
+// Rows of norm about sqrt(e) keep the determinant of a random matrix near
+// 1, so the double reference does not overflow at any size.
+static std::vector<float> random_row(std::size_t n, std::mt19937 &gen) {
+  float bound = std::sqrt(3 * std::exp(1.0f) / float(n));
+  std::uniform_real_distribution<float> dist(-bound, bound);
+  std::vector<float> row(n);
+  for (auto &value : row) {
+    value = dist(gen);
+  }
+  return row;
+}
+
+static void bench_determinant_tracker() {
+  std::println("DeterminantTracker row replacement vs det_blocked<double> from scratch");
+  std::println("{:>6} {:>14} {:>14} {:>14} {:>9}", "n", "update, s", "refactor, s", "det_blocked, s", "speedup");
+  for (std::size_t n : {128, 256, 512, 1024}) {
+    std::mt19937 gen(n);
+    auto matrix = Matrix::zeros(n);
+    for (std::size_t i = 0; i < n; i++) {
+      std::ranges::copy(random_row(n, gen), matrix.row(i).begin());
+    }
+
+    double refactor_time = time_seconds([&]() {
+      DeterminantTracker tracker(matrix);
+    });
+    // Interval above the number of updates: only the O(n^2) path is timed.
+    DeterminantTracker tracker(matrix, std::numeric_limits<std::size_t>::max());
+    std::vector<std::vector<float>> rows;
+    for (int k = 0; k < 16; k++) {
+      rows.push_back(random_row(n, gen));
+    }
+    double update_time = time_seconds([&]() {
+      for (std::size_t k = 0; k < rows.size(); k++) {
+        tracker.replace_row(k * 7 % n, rows[k]);
+      }
+    }) / double(rows.size());
+    double dense_time = time_seconds([&]() {
+      volatile double det = det_blocked<double>(matrix);
+      (void)det;
+    });
+    std::println("{:>6} {:>14.6f} {:>14.6f} {:>14.6f} {:>9.1f}", n, update_time, refactor_time, dense_time,
+                 dense_time / update_time);
+  }
+
+  std::println("Drift after 2000 row/column replacements, n = 256");
+  std::println("{:>10} {:>12}", "interval", "rel_error");
+  for (std::size_t interval : {std::size_t(16), std::size_t(64), std::size_t(256), std::numeric_limits<std::size_t>::max()}) {
+    std::mt19937 gen(1);
+    std::size_t n = 256;
+    auto matrix = Matrix::zeros(n);
+    for (std::size_t i = 0; i < n; i++) {
+      std::ranges::copy(random_row(n, gen), matrix.row(i).begin());
+    }
+
+    DeterminantTracker tracker(matrix, interval);
+    for (std::size_t k = 0; k < 2000; k++) {
+      auto line = random_row(n, gen);
+      auto target = (k * 37) % n;
+      if (k % 2 == 0) {
+        tracker.replace_row(target, line);
+        std::ranges::copy(line, matrix.row(target).begin());
+      } else {
+        tracker.replace_column(target, line);
+        for (std::size_t i = 0; i < n; i++) {
+          matrix(i, target) = line[i];
+        }
+      }
+    }
+    std::println("{:>10} {:>12}", interval == std::numeric_limits<std::size_t>::max() ? std::string("never") : std::to_string(interval),
+                 relative_error(tracker.determinant(), det_gauss<double>(matrix)));
+  }
+}
+
+// Runs every engine on every workload and size and writes one CSV row per
+// (workload, n, engine, threads). Matrices are rescaled by
+// normalize_determinant first. The reference determinant is det_exact
+// where it is affordable and det_gauss<double> elsewhere.
+static void bench_suite(std::ostream &csv) {
+  csv << "workload,n,engine,threads,time_s,speedup,efficiency,determinant,reference,rel_error\n";
+
+  for (const auto &workload : workloads()) {
+    for (std::size_t n : {4, 8, 10, 32, 64, 256, 1024}) {
+      int exponent;
+      auto integer_matrix = workload.generate(n);
+      auto matrix = normalize_determinant(integer_matrix, exponent);
+      bool exact = n <= 64;
+      double reference = exact ? det_exact(integer_matrix).to_double(exponent) : det_gauss<double>(matrix);
+
+      if (exact) {
+        double time = best_time([&]() {
+          det_exact(integer_matrix);
+        });
+        csv << workload.name << ',' << n << ",det_exact,1," << time << ",1,1," << reference << ",det_exact,0\n";
+      }
+
+      for (const auto &engine : engines()) {
+        if (n > engine.max_size) {
+          continue;
+        }
+
+        double serial_time = 0;
+        for (auto threads : engine.threaded ? thread_counts() : std::vector<std::size_t> {1}) {
+          double det = 0;
+          double time = best_time([&]() {
+            det = engine.run(matrix, threads);
+          });
+          if (threads == 1) {
+            serial_time = time;
+          }
+          double speedup = serial_time / time;
+          double error = reference == 0 ? std::fabs(det) : std::fabs((det - reference) / reference);
+
+          csv << workload.name << ',' << n << ',' << engine.name << ',' << threads << ','
+              << time << ',' << speedup << ',' << speedup / threads << ','
+              << det << ',' << (exact ? "det_exact" : "det_gauss<double>") << ',' << error << '\n';
+        }
+      }
+      csv.flush();
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  std::string_view section = argc > 1 ? argv[1] : "suite";
+
+  if (section == "suite") {
+    if (argc > 2) {
+      std::ofstream csv(argv[2]);
+      if (!csv.is_open()) {
+        std::println(stderr, "Unable to open {}", argv[2]);
+        return 1;
+      }
+      bench_suite(csv);
+    } else {
+      bench_suite(std::cout);
+    }
+  } else if (section == "scaling") {
+    bench_det_high_scaling();
+  } else if (section == "gauss") {
+    bench_det_gauss();
+  } else if (section == "blocked") {
+    bench_det_blocked();
+  } else if (section == "batch") {
+    bench_det_batch();
+  } else if (section == "exact") {
+    bench_det_exact();
+  } else if (section == "loading") {
+    bench_loading();
+  } else if (section == "sparse") {
+    bench_det_sparse();
+  } else if (section == "tracker") {
+    bench_determinant_tracker();
+  } else {
+    std::println(stderr, "usage: {} [suite [out.csv] | scaling | gauss | blocked | batch | exact | loading | sparse | tracker]", argv[0]);
+    return 1;
+  }
+  return 0;
+}
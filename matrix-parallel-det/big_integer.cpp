@@ -0,0 +1,295 @@
+#include "big_integer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+BigInteger::BigInteger(std::int64_t value) {
+  _negative = value < 0;
+  // Negate in unsigned arithmetic so INT64_MIN does not overflow.
+  std::uint64_t magnitude = _negative ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+  while (magnitude != 0) {
+    _limbs.push_back(static_cast<std::uint32_t>(magnitude));
+    magnitude >>= 32;
+  }
+}
+
+void BigInteger::trim() {
+  while (!_limbs.empty() && _limbs.back() == 0) {
+    _limbs.pop_back();
+  }
+  if (_limbs.empty()) {
+    _negative = false;
+  }
+}
+
+int BigInteger::compare_magnitude(const BigInteger &a, const BigInteger &b) {
+  if (a._limbs.size() != b._limbs.size()) {
+    return a._limbs.size() < b._limbs.size() ? -1 : 1;
+  }
+  for (std::size_t i = a._limbs.size(); i-- > 0;) {
+    if (a._limbs[i] != b._limbs[i]) {
+      return a._limbs[i] < b._limbs[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+void BigInteger::add_magnitude(BigInteger &a, const BigInteger &b) {
+  if (a._limbs.size() < b._limbs.size()) {
+    a._limbs.resize(b._limbs.size(), 0);
+  }
+
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < a._limbs.size(); i++) {
+    std::uint64_t sum = carry + a._limbs[i] + (i < b._limbs.size() ? b._limbs[i] : 0);
+    a._limbs[i] = static_cast<std::uint32_t>(sum);
+    carry = sum >> 32;
+    if (carry == 0 && i >= b._limbs.size()) {
+      break;
+    }
+  }
+  if (carry != 0) {
+    a._limbs.push_back(static_cast<std::uint32_t>(carry));
+  }
+}
+
+// |a| -= |b|, requires |a| >= |b|.
+void BigInteger::sub_magnitude(BigInteger &a, const BigInteger &b) {
+  std::int64_t borrow = 0;
+  for (std::size_t i = 0; i < a._limbs.size(); i++) {
+    std::int64_t diff = std::int64_t(a._limbs[i]) - borrow - (i < b._limbs.size() ? std::int64_t(b._limbs[i]) : 0);
+    borrow = diff < 0 ? 1 : 0;
+    a._limbs[i] = static_cast<std::uint32_t>(diff);
+    if (borrow == 0 && i >= b._limbs.size()) {
+      break;
+    }
+  }
+  a.trim();
+}
+
+BigInteger & BigInteger::operator+=(const BigInteger &other) {
+  if (_negative == other._negative) {
+    add_magnitude(*this, other);
+  } else if (compare_magnitude(*this, other) >= 0) {
+    sub_magnitude(*this, other);
+  } else {
+    BigInteger result = other;
+    sub_magnitude(result, *this);
+    *this = std::move(result);
+  }
+  return *this;
+}
+
+BigInteger & BigInteger::operator-=(const BigInteger &other) {
+  return *this += -other;
+}
+
+BigInteger BigInteger::operator-() const {
+  BigInteger result = *this;
+  if (!result.is_zero()) {
+    result._negative = !result._negative;
+  }
+  return result;
+}
+
+BigInteger operator*(const BigInteger &a, const BigInteger &b) {
+  BigInteger result;
+  if (a.is_zero() || b.is_zero()) {
+    return result;
+  }
+
+  result._limbs.assign(a._limbs.size() + b._limbs.size(), 0);
+  for (std::size_t i = 0; i < a._limbs.size(); i++) {
+    std::uint64_t carry = 0;
+    std::uint64_t ai = a._limbs[i];
+    for (std::size_t j = 0; j < b._limbs.size(); j++) {
+      std::uint64_t cur = ai * b._limbs[j] + result._limbs[i + j] + carry;
+      result._limbs[i + j] = static_cast<std::uint32_t>(cur);
+      carry = cur >> 32;
+    }
+    result._limbs[i + b._limbs.size()] = static_cast<std::uint32_t>(carry);
+  }
+  result._negative = a._negative != b._negative;
+  result.trim();
+  return result;
+}
+
+BigInteger & BigInteger::operator*=(const BigInteger &other) {
+  return *this = *this * other;
+}
+
+// Knuth's algorithm D on 32-bit limbs: |a| / |b|, truncated.
+BigInteger BigInteger::divide_magnitude(const BigInteger &a, const BigInteger &b) {
+  BigInteger quotient;
+  if (compare_magnitude(a, b) < 0) {
+    return quotient;
+  }
+
+  const auto &dividend = a._limbs;
+  const auto &divisor = b._limbs;
+  std::size_t n = divisor.size();
+  std::size_t m = dividend.size() - n;
+  quotient._limbs.assign(m + 1, 0);
+
+  if (n == 1) {
+    std::uint64_t rem = 0;
+    for (std::size_t i = dividend.size(); i-- > 0;) {
+      std::uint64_t cur = (rem << 32) | dividend[i];
+      quotient._limbs[i] = static_cast<std::uint32_t>(cur / divisor[0]);
+      rem = cur % divisor[0];
+    }
+    quotient.trim();
+    return quotient;
+  }
+
+  // Normalize so the top divisor limb has its high bit set.
+  int shift = std::countl_zero(divisor.back());
+  auto shifted = [shift](std::uint32_t high, std::uint32_t low) {
+    return shift == 0 ? high : static_cast<std::uint32_t>((high << shift) | (low >> (32 - shift)));
+  };
+
+  std::vector<std::uint32_t> v(n);
+  for (std::size_t i = n - 1; i > 0; i--) {
+    v[i] = shifted(divisor[i], divisor[i - 1]);
+  }
+  v[0] = divisor[0] << shift;
+
+  std::vector<std::uint32_t> u(dividend.size() + 1);
+  u[dividend.size()] = shifted(0, dividend.back());
+  for (std::size_t i = dividend.size() - 1; i > 0; i--) {
+    u[i] = shifted(dividend[i], dividend[i - 1]);
+  }
+  u[0] = dividend[0] << shift;
+
+  constexpr std::uint64_t base = std::uint64_t(1) << 32;
+  for (std::size_t j = m + 1; j-- > 0;) {
+    std::uint64_t numerator = (std::uint64_t(u[j + n]) << 32) | u[j + n - 1];
+    std::uint64_t qhat = numerator / v[n - 1];
+    std::uint64_t rhat = numerator % v[n - 1];
+    while (qhat >= base || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+      qhat--;
+      rhat += v[n - 1];
+      if (rhat >= base) {
+        break;
+      }
+    }
+
+    std::int64_t borrow = 0;
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      std::uint64_t product = qhat * v[i] + carry;
+      carry = product >> 32;
+      std::int64_t diff = std::int64_t(u[i + j]) - borrow - std::int64_t(product & 0xffffffff);
+      u[i + j] = static_cast<std::uint32_t>(diff);
+      borrow = diff < 0 ? 1 : 0;
+    }
+    std::int64_t diff = std::int64_t(u[j + n]) - borrow - std::int64_t(carry);
+    u[j + n] = static_cast<std::uint32_t>(diff);
+
+    if (diff < 0) {
+      // qhat was one too large: add the divisor back.
+      qhat--;
+      std::uint64_t sum_carry = 0;
+      for (std::size_t i = 0; i < n; i++) {
+        std::uint64_t sum = std::uint64_t(u[i + j]) + v[i] + sum_carry;
+        u[i + j] = static_cast<std::uint32_t>(sum);
+        sum_carry = sum >> 32;
+      }
+      u[j + n] += static_cast<std::uint32_t>(sum_carry);
+    }
+    quotient._limbs[j] = static_cast<std::uint32_t>(qhat);
+  }
+
+  quotient.trim();
+  return quotient;
+}
+
+BigInteger & BigInteger::operator/=(const BigInteger &other) {
+  if (other.is_zero()) {
+    throw std::domain_error("BigInteger division by zero");
+  }
+  bool negative = _negative != other._negative;
+  *this = divide_magnitude(*this, other);
+  _negative = negative && !is_zero();
+  return *this;
+}
+
+std::strong_ordering operator<=>(const BigInteger &a, const BigInteger &b) {
+  if (a._negative != b._negative) {
+    return a._negative ? std::strong_ordering::less : std::strong_ordering::greater;
+  }
+  int cmp = BigInteger::compare_magnitude(a, b);
+  if (a._negative) {
+    cmp = -cmp;
+  }
+  return cmp < 0 ? std::strong_ordering::less : cmp > 0 ? std::strong_ordering::greater : std::strong_ordering::equal;
+}
+
+bool BigInteger::fits_int64() const {
+  if (_limbs.size() <= 1) {
+    return true;
+  }
+  if (_limbs.size() > 2) {
+    return false;
+  }
+  std::uint64_t magnitude = (std::uint64_t(_limbs[1]) << 32) | _limbs[0];
+  return magnitude <= (_negative ? std::uint64_t(1) << 63 : (std::uint64_t(1) << 63) - 1);
+}
+
+std::int64_t BigInteger::to_int64() const {
+  if (!fits_int64()) {
+    throw std::overflow_error("BigInteger does not fit into int64_t");
+  }
+  std::uint64_t magnitude = 0;
+  for (std::size_t i = _limbs.size(); i-- > 0;) {
+    magnitude = (magnitude << 32) | _limbs[i];
+  }
+  return _negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+}
+
+double BigInteger::to_double(int exponent) const {
+  double result = 0;
+  // Three limbs cover the 53-bit mantissa; lower limbs cannot change it
+  // by more than rounding.
+  std::size_t lowest = _limbs.size() > 3 ? _limbs.size() - 3 : 0;
+  for (std::size_t i = _limbs.size(); i-- > lowest;) {
+    result = result * 4294967296.0 + _limbs[i];
+  }
+  result = std::ldexp(result, 32 * int(lowest) + exponent);
+  return _negative ? -result : result;
+}
+
+std::string BigInteger::to_string() const {
+  if (is_zero()) {
+    return "0";
+  }
+
+  std::vector<std::uint32_t> limbs = _limbs;
+  std::string digits;
+  while (!limbs.empty()) {
+    std::uint64_t rem = 0;
+    for (std::size_t i = limbs.size(); i-- > 0;) {
+      std::uint64_t cur = (rem << 32) | limbs[i];
+      limbs[i] = static_cast<std::uint32_t>(cur / 1'000'000'000);
+      rem = cur % 1'000'000'000;
+    }
+    while (!limbs.empty() && limbs.back() == 0) {
+      limbs.pop_back();
+    }
+    for (int k = 0; k < 9; k++) {
+      digits.push_back(char('0' + rem % 10));
+      rem /= 10;
+      if (limbs.empty() && rem == 0) {
+        break;
+      }
+    }
+  }
+
+  if (_negative) {
+    digits.push_back('-');
+  }
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision signed integer with just the arithmetic the exact
+// determinant needs. Magnitude is stored as little-endian 32-bit limbs
+// without leading zero limbs; zero has no limbs and is never negative.
+class BigInteger {
+  std::vector<std::uint32_t> _limbs;
+  bool _negative = false;
+
+  void trim();
+  static int compare_magnitude(const BigInteger &a, const BigInteger &b);
+  static void add_magnitude(BigInteger &a, const BigInteger &b);
+  static void sub_magnitude(BigInteger &a, const BigInteger &b);
+  static BigInteger divide_magnitude(const BigInteger &a, const BigInteger &b);
+public:
+  BigInteger() = default;
+  BigInteger(std::int64_t value);
+
+  BigInteger & operator+=(const BigInteger &other);
+  BigInteger & operator-=(const BigInteger &other);
+  BigInteger & operator*=(const BigInteger &other);
+  // Truncating division, like the built-in integer types.
+  BigInteger & operator/=(const BigInteger &other);
+
+  friend BigInteger operator+(BigInteger a, const BigInteger &b) {
+    return a += b;
+  }
+  friend BigInteger operator-(BigInteger a, const BigInteger &b) {
+    return a -= b;
+  }
+  friend BigInteger operator*(const BigInteger &a, const BigInteger &b);
+  friend BigInteger operator/(BigInteger a, const BigInteger &b) {
+    return a /= b;
+  }
+  BigInteger operator-() const;
+
+  friend bool operator==(const BigInteger &a, const BigInteger &b) = default;
+  friend std::strong_ordering operator<=>(const BigInteger &a, const BigInteger &b);
+
+  bool is_zero() const {
+    return _limbs.empty();
+  }
+
+  bool fits_int64() const;
+  std::int64_t to_int64() const;
+  // Value times 2^exponent; the scaling is applied before rounding to
+  // double, so huge values with a negative exponent do not overflow.
+  double to_double(int exponent = 0) const;
+  std::string to_string() const;
+};
@@ -0,0 +1,137 @@
+#include "determinant_tracker.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Updates with |1 + v^T A^-1 u| below this are recomputed from scratch:
+// dividing by a nearly cancelled term would wreck the inverse.
+static constexpr double cancellation_tolerance = 1e-8;
+
+DeterminantTracker::DeterminantTracker(const Matrix &matrix, std::size_t refactor_interval)
+    : _size(matrix.size()), _refactor_interval(std::max<std::size_t>(refactor_interval, 1)),
+      _matrix(_size * _size), _inverse(_size * _size), _u(_size), _v(_size), _w(_size), _z(_size) {
+  for (std::size_t i = 0; i < _size; i++) {
+    std::ranges::copy(matrix.row(i), _matrix.begin() + i * _size);
+  }
+  refactor();
+}
+
+void DeterminantTracker::refactor() {
+  std::size_t n = _size;
+  _updates = 0;
+  _singular = false;
+  _det = {};
+
+  auto work = _matrix;
+  std::ranges::fill(_inverse, 0);
+  for (std::size_t i = 0; i < n; i++) {
+    _inverse[i * n + i] = 1;
+  }
+
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot_row = k;
+    for (std::size_t i = k + 1; i < n; i++) {
+      if (std::fabs(work[i * n + k]) > std::fabs(work[pivot_row * n + k])) {
+        pivot_row = i;
+      }
+    }
+
+    double pivot = work[pivot_row * n + k];
+    if (pivot == 0) {
+      _singular = true;
+      return;
+    }
+    if (pivot_row != k) {
+      std::swap_ranges(work.begin() + k * n, work.begin() + (k + 1) * n, work.begin() + pivot_row * n);
+      std::swap_ranges(_inverse.begin() + k * n, _inverse.begin() + (k + 1) * n, _inverse.begin() + pivot_row * n);
+      _det.negate();
+    }
+    _det.multiply(pivot);
+
+    double *work_k = work.data() + k * n;
+    double *inverse_k = _inverse.data() + k * n;
+    for (std::size_t j = 0; j < n; j++) {
+      work_k[j] /= pivot;
+      inverse_k[j] /= pivot;
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      double factor = work[i * n + k];
+      if (i != k && factor != 0) {
+        row_update(work.data() + i * n + k, work_k + k, factor, n - k);
+        row_update(_inverse.data() + i * n, inverse_k, factor, n);
+      }
+    }
+  }
+}
+
+void DeterminantTracker::apply_update() {
+  std::size_t n = _size;
+  for (std::size_t i = 0; i < n; i++) {
+    if (_u[i] != 0) {
+      row_update(_matrix.data() + i * n, _v.data(), -_u[i], n);
+    }
+  }
+  if (_singular) {
+    refactor();
+    return;
+  }
+
+  // w = A^-1 u, z = v^T A^-1, both O(n^2).
+  double denominator = 1;
+  std::ranges::fill(_z, 0);
+  for (std::size_t i = 0; i < n; i++) {
+    const double *inverse_i = _inverse.data() + i * n;
+    double sum = 0;
+    for (std::size_t j = 0; j < n; j++) {
+      sum += inverse_i[j] * _u[j];
+    }
+    _w[i] = sum;
+    denominator += _v[i] * sum;
+    if (_v[i] != 0) {
+      row_update(_z.data(), inverse_i, -_v[i], n);
+    }
+  }
+
+  if (std::fabs(denominator) < cancellation_tolerance || ++_updates >= _refactor_interval) {
+    refactor();
+    return;
+  }
+
+  _det.multiply(denominator);
+  // (A + u v^T)^-1 = A^-1 - w z / (1 + v^T w).
+  for (std::size_t i = 0; i < n; i++) {
+    if (_w[i] != 0) {
+      row_update(_inverse.data() + i * n, _z.data(), _w[i] / denominator, n);
+    }
+  }
+}
+
+void DeterminantTracker::replace_row(std::size_t i, std::span<const float> row) {
+  assert(i < _size && row.size() == _size);
+  std::ranges::fill(_u, 0);
+  _u[i] = 1;
+  for (std::size_t j = 0; j < _size; j++) {
+    _v[j] = double(row[j]) - _matrix[i * _size + j];
+  }
+  apply_update();
+}
+
+void DeterminantTracker::replace_column(std::size_t j, std::span<const float> column) {
+  assert(j < _size && column.size() == _size);
+  for (std::size_t i = 0; i < _size; i++) {
+    _u[i] = double(column[i]) - _matrix[i * _size + j];
+  }
+  std::ranges::fill(_v, 0);
+  _v[j] = 1;
+  apply_update();
+}
+
+void DeterminantTracker::rank_one_update(std::span<const float> u, std::span<const float> v) {
+  assert(u.size() == _size && v.size() == _size);
+  std::ranges::copy(u, _u.begin());
+  std::ranges::copy(v, _v.begin());
+  apply_update();
+}
\ No newline at end of file
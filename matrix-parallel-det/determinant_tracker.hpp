@@ -0,0 +1,53 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "elimination.hpp"
+
+#include <span>
+#include <vector>
+
+// Determinant of a matrix that changes one row, one column or one rank-1
+// term at a time. A full Gauss-Jordan factorization gives the inverse and
+// the determinant once; every update after that costs O(n^2): the matrix
+// determinant lemma det(A + u v^T) = det(A) (1 + v^T A^-1 u) updates the
+// determinant and Sherman-Morrison updates the inverse.
+//
+// Rounding errors accumulate in the inverse, so it is recomputed from the
+// stored matrix every `refactor_interval` updates, and right away when an
+// update nearly cancels (|1 + v^T A^-1 u| tiny) or the matrix is singular.
+class DeterminantTracker {
+  std::size_t _size;
+  std::size_t _refactor_interval;
+  std::size_t _updates = 0;
+  bool _singular = false;
+  // Row-major, double precision: the current matrix and its inverse.
+  std::vector<double> _matrix;
+  std::vector<double> _inverse;
+  PivotProduct<double> _det;
+
+  // Scratch for the update vectors, A^-1 u and v^T A^-1.
+  std::vector<double> _u, _v, _w, _z;
+
+  void refactor();
+  // A += _u _v^T.
+  void apply_update();
+public:
+  explicit DeterminantTracker(const Matrix &matrix, std::size_t refactor_interval = 64);
+
+  void replace_row(std::size_t i, std::span<const float> row);
+  void replace_column(std::size_t j, std::span<const float> column);
+  // A += u v^T.
+  void rank_one_update(std::span<const float> u, std::span<const float> v);
+
+  double determinant() const {
+    return _singular ? 0 : _det.value();
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  std::size_t updates_since_refactor() const {
+    return _updates;
+  }
+};
\ No newline at end of file
@@ -1,48 +1,58 @@
 #include "determine.hpp"
 
-static float det_sequence(const Matrix &matrix) {
+static float det_sequence(const MinorView &matrix) {
   auto matrix_size = matrix.size();
   if (matrix_size == 1) {
-    return matrix.data()[0][0];
+    return matrix(0, 0);
   }
   if (matrix_size == 2) {
-    return matrix.data()[0][0] * matrix.data()[1][1] - matrix.data()[1][0] * matrix.data()[0][1];
+    return matrix(0, 0) * matrix(1, 1) - matrix(1, 0) * matrix(0, 1);
   }
 
-  float result = 0;
-  for (auto &&[i, num] : std::ranges::enumerate_view(matrix.data()[0])) {
+  KahanSum<float> result;
+  for (std::size_t i = 0; i < matrix_size; i++) {
+    if (matrix(0, i) == 0) {
+      continue;
+    }
     auto minor = matrix.minor(std::size_t(0), i);
     auto minor_det = det_sequence(minor);
-    result += num * minor_det * (i % 2 == 0 ? 1 : -1);
+    result.add(matrix(0, i) * minor_det * (i % 2 == 0 ? 1 : -1));
   }
 
-  return result;
+  return result.value();
 }
 
 float det_low(const Matrix &matrix, std::size_t thread_num) {
   auto matrix_size = matrix.size();
   if (matrix_size == 1) {
-    return matrix.data()[0][0];
+    return matrix(0, 0);
   }
   if (matrix_size == 2) {
-    return matrix.data()[0][0] * matrix.data()[1][1] - matrix.data()[1][0] * matrix.data()[0][1];
+    return matrix(0, 0) * matrix(1, 1) - matrix(1, 0) * matrix(0, 1);
   }
 
   std::vector<std::thread> threads;
   thread_num = std::min(thread_num, matrix_size);
   threads.reserve(thread_num);
 
-  std::atomic<float> result = 0;
+  MinorView view(matrix);
+  std::vector<float> partial(thread_num, 0);
   for (std::size_t i = 0; i < thread_num; ++i) {
     threads.emplace_back([&, i]() {
+      KahanSum<float> sum;
       auto idx = i;
       while (idx < matrix_size) {
-        auto num = matrix.data()[0][idx];
-        auto minor = matrix.minor(std::size_t(0), idx);
+        auto num = matrix(0, idx);
+        if (num == 0) {
+          idx += thread_num;
+          continue;
+        }
+        auto minor = view.minor(std::size_t(0), idx);
         auto minor_det = det_sequence(minor);
-        result += num * minor_det * (idx % 2 == 0 ? 1 : -1);
+        sum.add(num * minor_det * (idx % 2 == 0 ? 1 : -1));
         idx += thread_num;
       }
+      partial[i] = sum.value();
     });
   }
 
@@ -50,5 +60,9 @@ float det_low(const Matrix &matrix, std::size_t thread_num) {
     thread.join();
   }
 
-  return result;
+  KahanSum<float> result;
+  for (auto value : partial) {
+    result.add(value);
+  }
+  return result.value();
 }
\ No newline at end of file
@@ -1,14 +1,97 @@
 #pragma once
 
 #include "matrix.hpp"
+#include "thread_pool.hpp"
+#include "kernels.hpp"
+#include "big_integer.hpp"
+#include "sparse_matrix.hpp"
 
 // static size_t number_of_threads = 0;
 // static std::mutex mutex;
-static std::atomic<size_t> number_of_threads = 0;
-static size_t max_number_of_threads = 10;
+inline size_t max_number_of_threads = 10;
 // static size_t max_available_threads = std::thread::hardware_concurrency();
 
+// Minors up to this size are expanded inline by det_high instead of being
+// submitted to the pool as separate tasks.
+inline size_t det_high_task_cutoff = 6;
+
+// Panel width of det_blocked.
+inline size_t det_block_size = 64;
+
+// det_auto takes the sparse path for matrices of at least this size whose
+// fraction of nonzero entries is at most det_sparse_density. At n = 1024
+// the dense LU is already faster from about 0.5% nonzeros on.
+inline size_t det_sparse_min_size = 64;
+inline double det_sparse_density = 0.003;
+
+// Compensated (Kahan) summation: the rounding error of every addition is
+// carried into the next one.
+template <typename T>
+class KahanSum {
+  T _sum = 0;
+  T _compensation = 0;
+public:
+  void add(T value) {
+    T y = value - _compensation;
+    T t = _sum + y;
+    _compensation = (t - _sum) - y;
+    _sum = t;
+  }
+
+  T value() const {
+    return _sum;
+  }
+};
+
 void det_high(const Matrix &matrix, float &result);
 float det_low(const Matrix &matrix, std::size_t thread_num = 10);
 
+// Gaussian elimination with partial pivoting, O(n^3). The matrix is copied
+// into a working buffer of T, so det_gauss<double> is the double precision
+// path for float input. Row updates go through the SIMD kernels.
+template <typename T = float>
+T det_gauss(const Matrix &matrix);
+
+// Right-looking blocked LU with partial pivoting: each panel of
+// `block_size` columns is factored serially, then the trailing matrix gets
+// a GEMM-style rank-`block_size` update split into cache-sized tiles that
+// run in parallel on the shared pool.
+template <typename T = float>
+T det_blocked(const Matrix &matrix, std::size_t block_size = det_block_size, std::size_t thread_num = max_number_of_threads);
+
+// Exact determinant of an integer-valued matrix by fraction-free Bareiss
+// elimination, O(n^3). Runs in int64_t with 128-bit intermediates and
+// switches to BigInteger from the point where a value would overflow.
+// Throws std::invalid_argument if an entry is not an integer.
+BigInteger det_exact(const Matrix &matrix);
+
+// Determinants of many small matrices, parallelised across matrices rather
+// than within one. Runs of equal-size matrices up to 8x8 go through
+// compile-time unrolled SoA kernels; anything else falls back to det_gauss.
+void det_batch(std::span<const Matrix> matrices, std::span<float> results);
+
+// Determinant of a sparse matrix kept as mantissa * 2^exponent, since the
+// matrices worth factoring sparsely are usually far too large for the
+// plain value to fit in a double.
+struct SparseDeterminant {
+  double mantissa = 0;
+  long exponent = 0;
+  // Nonzeros of the L factor, a measure of the fill-in.
+  std::size_t factor_nonzeros = 0;
+
+  double value() const;
+  double log10_abs() const;
+};
+
+// Left-looking sparse LU (Gilbert-Peierls) in double precision. Columns
+// are taken in minimum_degree_ordering and the diagonal entry is kept as
+// pivot unless it is much smaller than the largest candidate, so the fill
+// stays close to what the ordering predicts.
+SparseDeterminant det_sparse(const SparseMatrix &matrix);
+
+// Picks the sparse or the dense (det_blocked<double>) engine from the size
+// and density of the matrix.
+double det_auto(const Matrix &matrix);
+double det_auto(const SparseMatrix &matrix);
+
 bool test();
\ No newline at end of file
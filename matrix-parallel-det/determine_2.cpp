@@ -1,41 +1,48 @@
 #include "determine.hpp"
 
-void det_high(const Matrix &matrix, float &result){
+static void det_high_minor(const MinorView &matrix, float &result, ThreadPool *pool){
   size_t matrix_size = matrix.size();
 
   if (matrix_size == 1) {
-    result = matrix.data()[0][0];
+    result = matrix(0, 0);
     return;
   }
   if (matrix_size == 2) {
-    result = matrix.data()[0][0] * matrix.data()[1][1] - matrix.data()[1][0] * matrix.data()[0][1];
+    result = matrix(0, 0) * matrix(1, 1) - matrix(1, 0) * matrix(0, 1);
     return;
   }
 
   float det = 0;
-  std::vector<float> threads_results(matrix_size, 0);
-//{
-  std::vector<std::thread> threads;
-
-  for (int i = 0; i < matrix_size; i++) {
-    auto minor = matrix.minor(std::size_t(0), i);
-
-    if (number_of_threads.load() < max_number_of_threads) {
-      threads.emplace_back(det_high, minor, std::ref(threads_results[i]));
-      number_of_threads.fetch_add(1);
-    } else {
-      det_high(minor, threads_results[i]);
+  std::array<float, MinorView::max_size> threads_results{};
+
+  if (pool != nullptr && matrix_size > det_high_task_cutoff) {
+    TaskGroup group(*pool);
+    for (size_t i = 0; i < matrix_size; i++) {
+      if (matrix(0, i) == 0) {
+        continue;
+      }
+      group.run([&matrix, &threads_results, pool, i]() {
+        det_high_minor(matrix.minor(std::size_t(0), i), threads_results[i], pool);
+      });
+    }
+    group.wait();
+  } else {
+    for (size_t i = 0; i < matrix_size; i++) {
+      if (matrix(0, i) == 0) {
+        continue;
+      }
+      det_high_minor(matrix.minor(std::size_t(0), i), threads_results[i], nullptr);
     }
-  }
-//}
-
-  for (auto &thread : threads) {
-    thread.join();
   }
 
   for (int j = 0; j < matrix_size; j++) {
-    det += (j % 2 == 0 ? 1 : -1) * matrix.data()[0][j] * threads_results[j];
+    det += (j % 2 == 0 ? 1 : -1) * matrix(0, j) * threads_results[j];
   }
 
   result = det;
+}
+
+void det_high(const Matrix &matrix, float &result){
+  auto pool = shared_pool(max_number_of_threads);
+  det_high_minor(MinorView(matrix), result, pool.get());
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "determine.hpp"
+
+#include <cmath>
+
+// Matrices handled together by one SoA kernel call; matches the widest
+// float vector so every lane loop below maps onto whole registers.
+static constexpr std::size_t batch_lanes = 16;
+static constexpr std::size_t batch_chunk = 4096;
+static constexpr std::size_t batch_max_size = 8;
+
+// Elimination over `batch_lanes` matrices of size N at once. Element (i, j)
+// of every matrix in the batch is stored contiguously, so each step is a
+// loop over lanes. Pivoting is branchless: every lower row is compared with
+// the pivot row and swapped in where its entry is larger.
+template <std::size_t N>
+static void det_soa(const Matrix *matrices, std::size_t count, float *out) {
+  alignas(64) float a[N][N][batch_lanes];
+  alignas(64) float det[batch_lanes];
+
+  for (std::size_t l = 0; l < batch_lanes; l++) {
+    for (std::size_t i = 0; i < N; i++) {
+      for (std::size_t j = 0; j < N; j++) {
+        a[i][j][l] = l < count ? matrices[l](i, j) : (i == j ? 1.0f : 0.0f);
+      }
+    }
+    det[l] = 1;
+  }
+
+  for (std::size_t k = 0; k < N; k++) {
+    for (std::size_t r = k + 1; r < N; r++) {
+      for (std::size_t l = 0; l < batch_lanes; l++) {
+        bool swap = std::fabs(a[r][k][l]) > std::fabs(a[k][k][l]);
+        for (std::size_t j = k; j < N; j++) {
+          float top = a[k][j][l];
+          float bottom = a[r][j][l];
+          a[k][j][l] = swap ? bottom : top;
+          a[r][j][l] = swap ? top : bottom;
+        }
+        det[l] = swap ? -det[l] : det[l];
+      }
+    }
+
+    alignas(64) float inv[batch_lanes];
+    for (std::size_t l = 0; l < batch_lanes; l++) {
+      float pivot = a[k][k][l];
+      det[l] *= pivot;
+      inv[l] = pivot != 0 ? 1.0f / pivot : 0.0f;
+    }
+
+    for (std::size_t i = k + 1; i < N; i++) {
+      alignas(64) float factor[batch_lanes];
+      for (std::size_t l = 0; l < batch_lanes; l++) {
+        factor[l] = a[i][k][l] * inv[l];
+      }
+      for (std::size_t j = k + 1; j < N; j++) {
+        for (std::size_t l = 0; l < batch_lanes; l++) {
+          a[i][j][l] -= factor[l] * a[k][j][l];
+        }
+      }
+    }
+  }
+
+  std::copy(det, det + count, out);
+}
+
+template <std::size_t... Sizes>
+static bool det_soa_dispatch(std::size_t n, const Matrix *matrices, std::size_t count, float *out,
+                             std::index_sequence<Sizes...>) {
+  return ((n == Sizes + 1 && (det_soa<Sizes + 1>(matrices, count, out), true)) || ...);
+}
+
+static void det_batch_chunk(std::span<const Matrix> matrices, std::span<float> results) {
+  for (std::size_t first = 0; first < matrices.size(); first += batch_lanes) {
+    auto count = std::min(batch_lanes, matrices.size() - first);
+    auto lanes = matrices.subspan(first, count);
+    auto n = lanes.front().size();
+
+    bool same_size = std::ranges::all_of(lanes, [n](const Matrix &m) {
+      return m.size() == n;
+    });
+    if (same_size && det_soa_dispatch(n, lanes.data(), count, &results[first],
+                                      std::make_index_sequence<batch_max_size>())) {
+      continue;
+    }
+
+    for (std::size_t l = 0; l < count; l++) {
+      results[first + l] = det_gauss<float>(lanes[l]);
+    }
+  }
+}
+
+void det_batch(std::span<const Matrix> matrices, std::span<float> results) {
+  assert(results.size() >= matrices.size());
+
+  if (matrices.size() <= batch_chunk) {
+    det_batch_chunk(matrices, results);
+    return;
+  }
+
+  auto pool = shared_pool(max_number_of_threads);
+  TaskGroup group(*pool);
+  for (std::size_t first = 0; first < matrices.size(); first += batch_chunk) {
+    auto count = std::min(batch_chunk, matrices.size() - first);
+    group.run([matrices, results, first, count]() {
+      det_batch_chunk(matrices.subspan(first, count), results.subspan(first, count));
+    });
+  }
+  group.wait();
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "determine.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+struct BareissProgress {
+  std::size_t step = 0;
+  std::size_t row = 1;
+  bool negative = false;
+};
+
+// One fraction-free update: (a_ij * a_kk - a_ik * a_kj) / prev. The division
+// is exact. The int64_t version computes in 128 bits and reports overflow
+// instead of wrapping.
+bool bareiss_update(std::int64_t a_ij, std::int64_t a_kk, std::int64_t a_ik, std::int64_t a_kj, std::int64_t prev,
+                    std::int64_t &out) {
+  __int128 value = (__int128)a_ij * a_kk - (__int128)a_ik * a_kj;
+  value /= prev;
+  if (value > INT64_MAX || value < INT64_MIN) {
+    return false;
+  }
+  out = static_cast<std::int64_t>(value);
+  return true;
+}
+
+bool bareiss_update(const BigInteger &a_ij, const BigInteger &a_kk, const BigInteger &a_ik, const BigInteger &a_kj,
+                    const BigInteger &prev, BigInteger &out) {
+  out = (a_ij * a_kk - a_ik * a_kj) / prev;
+  return true;
+}
+
+bool is_zero(std::int64_t value) {
+  return value == 0;
+}
+
+bool is_zero(const BigInteger &value) {
+  return value.is_zero();
+}
+
+// Continues elimination from `progress`. A row is written back only once
+// all of its entries are computed, so on overflow `a` still describes a
+// valid point of the algorithm and another Int type can resume from it.
+template <typename Int>
+bool bareiss(std::vector<Int> &a, std::size_t n, BareissProgress &progress) {
+  std::vector<Int> row_buffer(n);
+
+  for (; progress.step + 1 < n; progress.step++, progress.row = progress.step + 1) {
+    std::size_t k = progress.step;
+    auto at = [&a, n](std::size_t i, std::size_t j) -> Int & {
+      return a[i * n + j];
+    };
+
+    if (progress.row == k + 1 && is_zero(at(k, k))) {
+      std::size_t pivot_row = k + 1;
+      while (pivot_row < n && is_zero(at(pivot_row, k))) {
+        pivot_row++;
+      }
+      if (pivot_row == n) {
+        at(n - 1, n - 1) = 0;
+        progress.step = n - 1;
+        return true;
+      }
+      std::swap_ranges(a.begin() + k * n, a.begin() + (k + 1) * n, a.begin() + pivot_row * n);
+      progress.negative = !progress.negative;
+    }
+
+    const Int prev = k == 0 ? Int(1) : at(k - 1, k - 1);
+    for (; progress.row < n; progress.row++) {
+      std::size_t i = progress.row;
+      for (std::size_t j = k + 1; j < n; j++) {
+        if (!bareiss_update(at(i, j), at(k, k), at(i, k), at(k, j), prev, row_buffer[j])) {
+          return false;
+        }
+      }
+      for (std::size_t j = k + 1; j < n; j++) {
+        at(i, j) = std::move(row_buffer[j]);
+      }
+    }
+  }
+
+  return true;
+}
+
+}
+
+BigInteger det_exact(const Matrix &matrix) {
+  std::size_t n = matrix.size();
+  if (n == 0) {
+    return 1;
+  }
+
+  std::vector<std::int64_t> a(n * n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      float value = matrix(i, j);
+      if (std::trunc(value) != value || std::fabs(value) >= 0x1p63f) {
+        throw std::invalid_argument("Matrix has non-integer entries");
+      }
+      a[i * n + j] = static_cast<std::int64_t>(value);
+    }
+  }
+
+  BareissProgress progress;
+  BigInteger det;
+  if (bareiss(a, n, progress)) {
+    det = a.back();
+  } else {
+    std::vector<BigInteger> big(a.begin(), a.end());
+    bareiss(big, n, progress);
+    det = std::move(big.back());
+  }
+
+  return progress.negative ? -det : det;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "determine.hpp"
+#include "elimination.hpp"
+
+template <typename T>
+T det_gauss(const Matrix &matrix) {
+  std::size_t n = matrix.size();
+  WorkMatrix<T> a(matrix);
+  PivotProduct<T> det;
+
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot_row = k;
+    for (std::size_t i = k + 1; i < n; i++) {
+      if (std::abs(a(i, k)) > std::abs(a(pivot_row, k))) {
+        pivot_row = i;
+      }
+    }
+
+    T pivot = a(pivot_row, k);
+    if (pivot == 0) {
+      return 0;
+    }
+    if (pivot_row != k) {
+      a.swap_rows(k, pivot_row);
+      det.negate();
+    }
+    det.multiply(pivot);
+
+    const T *pivot_tail = a.row(k) + k + 1;
+    for (std::size_t i = k + 1; i < n; i++) {
+      T factor = a(i, k) / pivot;
+      if (factor != 0) {
+        row_update(a.row(i) + k + 1, pivot_tail, factor, n - k - 1);
+      }
+    }
+  }
+
+  return det.value();
+}
+
+template float det_gauss<float>(const Matrix &matrix);
+template double det_gauss<double>(const Matrix &matrix);
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "determine.hpp"
+#include "elimination.hpp"
+
+// Columns of the trailing matrix updated by one task. A tile of U12 is
+// block_size x lu_tile_cols and stays in L2 while every row of the tile
+// streams past it.
+static constexpr std::size_t lu_tile_cols = 256;
+static constexpr std::size_t lu_tile_rows = 64;
+
+// Factors columns [k0, k0 + kb) of the rows below k0 in place, swapping
+// whole rows for pivoting. Returns false if the matrix is singular.
+template <typename T>
+static bool factor_panel(WorkMatrix<T> &a, std::size_t k0, std::size_t kb, PivotProduct<T> &det) {
+  std::size_t n = a.size();
+  std::size_t panel_end = k0 + kb;
+
+  for (std::size_t k = k0; k < panel_end; k++) {
+    std::size_t pivot_row = k;
+    for (std::size_t i = k + 1; i < n; i++) {
+      if (std::abs(a(i, k)) > std::abs(a(pivot_row, k))) {
+        pivot_row = i;
+      }
+    }
+
+    T pivot = a(pivot_row, k);
+    if (pivot == 0) {
+      return false;
+    }
+    if (pivot_row != k) {
+      a.swap_rows(k, pivot_row);
+      det.negate();
+    }
+    det.multiply(pivot);
+
+    const T *pivot_tail = a.row(k) + k + 1;
+    for (std::size_t i = k + 1; i < n; i++) {
+      T factor = a(i, k) / pivot;
+      a(i, k) = factor;
+      if (factor != 0) {
+        row_update(a.row(i) + k + 1, pivot_tail, factor, panel_end - k - 1);
+      }
+    }
+  }
+
+  return true;
+}
+
+// U12 = L11^-1 * A12 for the rows of the panel.
+template <typename T>
+static void solve_panel_rows(WorkMatrix<T> &a, std::size_t k0, std::size_t kb) {
+  std::size_t n = a.size();
+  std::size_t panel_end = k0 + kb;
+
+  for (std::size_t k = k0; k < panel_end; k++) {
+    for (std::size_t i = k + 1; i < panel_end; i++) {
+      T factor = a(i, k);
+      if (factor != 0) {
+        row_update(a.row(i) + panel_end, a.row(k) + panel_end, factor, n - panel_end);
+      }
+    }
+  }
+}
+
+// A22[rows, cols] -= L21[rows, panel] * U12[panel, cols].
+template <typename T>
+static void update_tile(WorkMatrix<T> &a, std::size_t k0, std::size_t kb,
+                        std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+  for (std::size_t i = row_begin; i < row_end; i++) {
+    T *dst = a.row(i) + col_begin;
+    for (std::size_t p = k0; p < k0 + kb; p++) {
+      T factor = a(i, p);
+      if (factor != 0) {
+        row_update(dst, a.row(p) + col_begin, factor, col_end - col_begin);
+      }
+    }
+  }
+}
+
+template <typename T>
+T det_blocked(const Matrix &matrix, std::size_t block_size, std::size_t thread_num) {
+  std::size_t n = matrix.size();
+  block_size = std::max<std::size_t>(block_size, 1);
+
+  WorkMatrix<T> a(matrix);
+  PivotProduct<T> det;
+  auto pool = thread_num > 1 ? shared_pool(thread_num) : nullptr;
+
+  for (std::size_t k0 = 0; k0 < n; k0 += block_size) {
+    std::size_t kb = std::min(block_size, n - k0);
+    std::size_t next = k0 + kb;
+
+    if (!factor_panel(a, k0, kb, det)) {
+      return 0;
+    }
+    if (next == n) {
+      break;
+    }
+    solve_panel_rows(a, k0, kb);
+
+    if (pool == nullptr) {
+      for (std::size_t col = next; col < n; col += lu_tile_cols) {
+        update_tile(a, k0, kb, next, n, col, std::min(n, col + lu_tile_cols));
+      }
+      continue;
+    }
+
+    TaskGroup group(*pool);
+    for (std::size_t row = next; row < n; row += lu_tile_rows) {
+      for (std::size_t col = next; col < n; col += lu_tile_cols) {
+        group.run([&a, k0, kb, row, col, n]() {
+          update_tile(a, k0, kb, row, std::min(n, row + lu_tile_rows), col, std::min(n, col + lu_tile_cols));
+        });
+      }
+    }
+    group.wait();
+  }
+
+  return det.value();
+}
+
+template float det_blocked<float>(const Matrix &matrix, std::size_t block_size, std::size_t thread_num);
+template double det_blocked<double>(const Matrix &matrix, std::size_t block_size, std::size_t thread_num);
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "determine.hpp"
+#include "elimination.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// A diagonal pivot is accepted while it is at least this fraction of the
+// largest candidate in its column.
+static constexpr double diagonal_pivot_tolerance = 0.1;
+
+static constexpr std::size_t unassigned = std::numeric_limits<std::size_t>::max();
+
+// Unit lower triangular factor, one column per pivot step. Row indices are
+// rows of the original matrix.
+struct LowerFactor {
+  std::vector<std::size_t> col_start = {0};
+  std::vector<std::size_t> row_index;
+  std::vector<double> values;
+};
+
+// Rows reachable from the pattern of column `col` in the graph of L, i.e.
+// the nonzero pattern of L^-1 * A(:, col). Written to stack[top..n) in
+// topological order; returns top.
+static std::size_t reach(const SparseMatrix &matrix, std::size_t col, const LowerFactor &lower,
+                         const std::vector<std::size_t> &pivot_step, std::vector<std::size_t> &mark,
+                         std::size_t stamp, std::vector<std::size_t> &stack, std::vector<std::size_t> &path,
+                         std::vector<std::size_t> &next_child) {
+  std::size_t top = stack.size();
+  for (auto start : matrix.column_rows(col)) {
+    if (mark[start] == stamp) {
+      continue;
+    }
+
+    // Iterative depth-first search, path[] being the recursion stack.
+    std::size_t depth = 0;
+    path[0] = start;
+    while (true) {
+      auto row = path[depth];
+      auto step = pivot_step[row];
+      if (mark[row] != stamp) {
+        mark[row] = stamp;
+        next_child[depth] = step == unassigned ? 0 : lower.col_start[step];
+      }
+
+      bool finished = true;
+      std::size_t end = step == unassigned ? 0 : lower.col_start[step + 1];
+      for (auto p = next_child[depth]; p < end; p++) {
+        auto child = lower.row_index[p];
+        if (mark[child] != stamp) {
+          next_child[depth] = p + 1;
+          path[++depth] = child;
+          finished = false;
+          break;
+        }
+      }
+
+      if (finished) {
+        stack[--top] = row;
+        if (depth == 0) {
+          break;
+        }
+        depth--;
+      }
+    }
+  }
+  return top;
+}
+
+// Sign of a permutation given as an array, by counting cycles.
+static bool is_odd_permutation(const std::vector<std::size_t> &permutation) {
+  std::vector<char> seen(permutation.size(), 0);
+  std::size_t transpositions = 0;
+  for (std::size_t i = 0; i < permutation.size(); i++) {
+    std::size_t length = 0;
+    for (auto j = i; !seen[j]; j = permutation[j]) {
+      seen[j] = 1;
+      length++;
+    }
+    transpositions += length > 0 ? length - 1 : 0;
+  }
+  return transpositions % 2 == 1;
+}
+
+SparseDeterminant det_sparse(const SparseMatrix &matrix) {
+  std::size_t n = matrix.size();
+  SparseDeterminant result;
+  if (n == 0) {
+    result.mantissa = 1;
+    return result;
+  }
+
+  auto order = minimum_degree_ordering(matrix);
+
+  LowerFactor lower;
+  std::vector<std::size_t> pivot_step(n, unassigned);
+  std::vector<std::size_t> pivot_rows(n);
+  std::vector<std::size_t> mark(n, 0);
+  std::vector<std::size_t> stack(n), path(n), next_child(n);
+  std::vector<double> x(n, 0);
+  PivotProduct<double> product;
+
+  for (std::size_t k = 0; k < n; k++) {
+    auto col = order[k];
+    auto top = reach(matrix, col, lower, pivot_step, mark, k + 1, stack, path, next_child);
+
+    // Sparse triangular solve x = L^-1 * A(:, col) over the reached rows.
+    for (auto p = top; p < n; p++) {
+      x[stack[p]] = 0;
+    }
+    auto rows = matrix.column_rows(col);
+    auto values = matrix.column_values(col);
+    for (std::size_t p = 0; p < rows.size(); p++) {
+      x[rows[p]] = values[p];
+    }
+    for (auto p = top; p < n; p++) {
+      auto row = stack[p];
+      auto step = pivot_step[row];
+      if (step == unassigned) {
+        continue;
+      }
+      auto xj = x[row];
+      for (auto q = lower.col_start[step]; q < lower.col_start[step + 1]; q++) {
+        x[lower.row_index[q]] -= lower.values[q] * xj;
+      }
+    }
+
+    std::size_t pivot_row = unassigned;
+    double largest = 0;
+    for (auto p = top; p < n; p++) {
+      auto row = stack[p];
+      if (pivot_step[row] == unassigned && std::fabs(x[row]) > largest) {
+        largest = std::fabs(x[row]);
+        pivot_row = row;
+      }
+    }
+    if (pivot_row == unassigned) {
+      // Structurally or numerically singular.
+      result.factor_nonzeros = lower.values.size();
+      return result;
+    }
+    // x[col] is only valid when row col was reached in this column; otherwise
+    // it is left over from an earlier one and the entry is structurally zero.
+    if (mark[col] == k + 1 && pivot_step[col] == unassigned &&
+        std::fabs(x[col]) >= diagonal_pivot_tolerance * largest) {
+      pivot_row = col;
+    }
+
+    double pivot = x[pivot_row];
+    product.multiply(pivot);
+    pivot_step[pivot_row] = k;
+    pivot_rows[k] = pivot_row;
+
+    for (auto p = top; p < n; p++) {
+      auto row = stack[p];
+      if (pivot_step[row] == unassigned && x[row] != 0) {
+        lower.row_index.push_back(row);
+        lower.values.push_back(x[row] / pivot);
+      }
+    }
+    lower.col_start.push_back(lower.values.size());
+  }
+
+  // P * A * Q = L * U with row k of the factors being pivot_rows[k] and
+  // column k being order[k]; det(A) = det(U) * sign(P) * sign(Q).
+  if (is_odd_permutation(pivot_rows) != is_odd_permutation(order)) {
+    product.negate();
+  }
+  result.mantissa = product.mantissa();
+  result.exponent = product.exponent();
+  result.factor_nonzeros = lower.values.size();
+  return result;
+}
+
+double SparseDeterminant::value() const {
+  if (mantissa == 0) {
+    return 0;
+  }
+  // Clamp so ldexp saturates to inf or 0 instead of wrapping the int.
+  auto clamped = std::clamp<long>(exponent, std::numeric_limits<int>::min() / 2, std::numeric_limits<int>::max() / 2);
+  return std::ldexp(mantissa, int(clamped));
+}
+
+double SparseDeterminant::log10_abs() const {
+  if (mantissa == 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  return std::log10(std::fabs(mantissa)) + double(exponent) * std::log10(2.0);
+}
+
+double det_auto(const Matrix &matrix) {
+  std::size_t n = matrix.size();
+  if (n >= det_sparse_min_size) {
+    std::size_t nonzeros = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      for (auto value : matrix.row(i)) {
+        nonzeros += value != 0;
+      }
+    }
+    if (double(nonzeros) <= det_sparse_density * double(n) * double(n)) {
+      return det_sparse(SparseMatrix::from_dense(matrix)).value();
+    }
+  }
+  return det_blocked<double>(matrix);
+}
+
+double det_auto(const SparseMatrix &matrix) {
+  if (matrix.size() >= det_sparse_min_size && matrix.density() <= det_sparse_density) {
+    return det_sparse(matrix).value();
+  }
+  return det_blocked<double>(matrix.to_dense());
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "matrix.hpp"
+
+#include <cmath>
+
+// Dense working copy of a Matrix in precision T for the elimination
+// engines. Rows are padded to Matrix::alignment like Matrix itself.
+template <typename T>
+class WorkMatrix {
+  std::size_t _size;
+  std::size_t _stride;
+  std::vector<T, AlignedAllocator<T, Matrix::alignment>> _data;
+public:
+  explicit WorkMatrix(const Matrix &matrix) : _size(matrix.size()) {
+    constexpr std::size_t lanes = Matrix::alignment / sizeof(T);
+    _stride = (_size + lanes - 1) / lanes * lanes;
+    _data.resize(_size * _stride);
+    for (std::size_t i = 0; i < _size; i++) {
+      std::ranges::copy(matrix.row(i), row(i));
+    }
+  }
+
+  T *row(std::size_t i) {
+    return _data.data() + i * _stride;
+  }
+
+  T &operator()(std::size_t i, std::size_t j) {
+    return _data[i * _stride + j];
+  }
+
+  void swap_rows(std::size_t a, std::size_t b) {
+    std::swap_ranges(row(a), row(a) + _size, row(b));
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+};
+
+// Product of pivots kept as mantissa * 2^exponent, so that it does not
+// overflow or underflow halfway through a large matrix.
+template <typename T>
+class PivotProduct {
+  T _mantissa = 1;
+  int _exponent = 0;
+public:
+  void multiply(T pivot) {
+    int exponent;
+    _mantissa *= std::frexp(pivot, &exponent);
+    _exponent += exponent;
+    _mantissa = std::frexp(_mantissa, &exponent);
+    _exponent += exponent;
+  }
+
+  void negate() {
+    _mantissa = -_mantissa;
+  }
+
+  T value() const {
+    return std::ldexp(_mantissa, _exponent);
+  }
+
+  T mantissa() const {
+    return _mantissa;
+  }
+
+  int exponent() const {
+    return _exponent;
+  }
+};
\ No newline at end of file
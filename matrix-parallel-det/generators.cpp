@@ -0,0 +1,104 @@
+#include "generators.hpp"
+
+#include <random>
+
+Matrix random_matrix(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-9, 9);
+
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto &value : matrix.row(i)) {
+      value = dist(gen);
+    }
+  }
+  return matrix;
+}
+
+Matrix data_like_matrix(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, 100);
+
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto &value : matrix.row(i)) {
+      value = dist(gen);
+    }
+  }
+  return matrix;
+}
+
+Matrix sparse_matrix(std::size_t n, double density, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(1, 9);
+  std::bernoulli_distribution present(density);
+  std::bernoulli_distribution negative(0.5);
+
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      if (i == j || present(gen)) {
+        matrix(i, j) = negative(gen) ? -dist(gen) : dist(gen);
+      }
+    }
+  }
+  return matrix;
+}
+
+Matrix banded_matrix(std::size_t n, std::size_t bandwidth, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-9, 9);
+
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    std::size_t first = i > bandwidth ? i - bandwidth : 0;
+    std::size_t last = std::min(n - 1, i + bandwidth);
+    for (std::size_t j = first; j <= last; j++) {
+      matrix(i, j) = dist(gen);
+    }
+    matrix(i, i) += 20;
+  }
+  return matrix;
+}
+
+Matrix ill_conditioned_matrix(std::size_t n, unsigned seed) {
+  auto matrix = random_matrix(n, seed);
+  if (n >= 2) {
+    std::ranges::copy(matrix.row(n - 2), matrix.row(n - 1).begin());
+    matrix(n - 1, seed % n) += 1;
+  }
+  return matrix;
+}
+
+SparseMatrix banded_sparse_matrix(std::size_t n, std::size_t bandwidth, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-9, 9);
+
+  std::vector<SparseMatrix::Entry> entries;
+  entries.reserve(n * (2 * bandwidth + 1));
+  for (std::size_t i = 0; i < n; i++) {
+    std::size_t first = i > bandwidth ? i - bandwidth : 0;
+    std::size_t last = std::min(n - 1, i + bandwidth);
+    for (std::size_t j = first; j <= last; j++) {
+      entries.push_back({i, j, float(dist(gen) + (i == j ? 20 : 0))});
+    }
+  }
+  return SparseMatrix::from_entries(n, std::move(entries));
+}
+
+SparseMatrix random_sparse_matrix(std::size_t n, std::size_t per_row, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(1, 9);
+  std::uniform_int_distribution<std::size_t> column(0, n - 1);
+  std::bernoulli_distribution negative(0.5);
+
+  std::vector<SparseMatrix::Entry> entries;
+  entries.reserve(n * (per_row + 1));
+  for (std::size_t i = 0; i < n; i++) {
+    entries.push_back({i, i, float(negative(gen) ? -dist(gen) : dist(gen))});
+    for (std::size_t k = 0; k < per_row; k++) {
+      entries.push_back({i, column(gen), float(negative(gen) ? -dist(gen) : dist(gen))});
+    }
+  }
+  return SparseMatrix::from_entries(n, std::move(entries));
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+
+// Integer-valued test matrices, so det_exact can serve as the reference.
+// Every generator is deterministic in `seed`.
+
+// Dense, entries uniform in [-9, 9].
+Matrix random_matrix(std::size_t n, unsigned seed);
+
+// Same entry range as the data/matrix_*.txt files: [0, 100].
+Matrix data_like_matrix(std::size_t n, unsigned seed);
+
+// Nonzero diagonal plus off-diagonal entries present with probability
+// `density`.
+Matrix sparse_matrix(std::size_t n, double density, unsigned seed);
+
+// Entries only within `bandwidth` of the diagonal.
+Matrix banded_matrix(std::size_t n, std::size_t bandwidth, unsigned seed);
+
+// Dense random matrix whose last row differs from the previous one in a
+// single entry, so the determinant is tiny next to the entries' scale.
+Matrix ill_conditioned_matrix(std::size_t n, unsigned seed);
+
+// Sparse counterparts of banded_matrix and sparse_matrix for sizes that do
+// not fit densely: the same entry ranges, but random_sparse_matrix places
+// `per_row` off-diagonal entries in every row instead of using a density.
+SparseMatrix banded_sparse_matrix(std::size_t n, std::size_t bandwidth, unsigned seed);
+SparseMatrix random_sparse_matrix(std::size_t n, std::size_t per_row, unsigned seed);
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DET_X86_KERNELS 1
+#endif
+
+template <typename T>
+static void row_update_scalar(T *dst, const T *src, T factor, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) {
+    dst[j] -= factor * src[j];
+  }
+}
+
+#ifdef DET_X86_KERNELS
+__attribute__((target("avx2,fma")))
+static void row_update_avx2(float *dst, const float *src, float factor, std::size_t n) {
+  auto f = _mm256_set1_ps(factor);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    auto d = _mm256_loadu_ps(dst + j);
+    _mm256_storeu_ps(dst + j, _mm256_fnmadd_ps(f, _mm256_loadu_ps(src + j), d));
+  }
+  row_update_scalar(dst + j, src + j, factor, n - j);
+}
+
+__attribute__((target("avx2,fma")))
+static void row_update_avx2(double *dst, const double *src, double factor, std::size_t n) {
+  auto f = _mm256_set1_pd(factor);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    auto d = _mm256_loadu_pd(dst + j);
+    _mm256_storeu_pd(dst + j, _mm256_fnmadd_pd(f, _mm256_loadu_pd(src + j), d));
+  }
+  row_update_scalar(dst + j, src + j, factor, n - j);
+}
+
+__attribute__((target("avx512f")))
+static void row_update_avx512(float *dst, const float *src, float factor, std::size_t n) {
+  auto f = _mm512_set1_ps(factor);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    auto d = _mm512_loadu_ps(dst + j);
+    _mm512_storeu_ps(dst + j, _mm512_fnmadd_ps(f, _mm512_loadu_ps(src + j), d));
+  }
+  if (j < n) {
+    __mmask16 mask = (1u << (n - j)) - 1;
+    auto d = _mm512_maskz_loadu_ps(mask, dst + j);
+    auto s = _mm512_maskz_loadu_ps(mask, src + j);
+    _mm512_mask_storeu_ps(dst + j, mask, _mm512_fnmadd_ps(f, s, d));
+  }
+}
+
+__attribute__((target("avx512f")))
+static void row_update_avx512(double *dst, const double *src, double factor, std::size_t n) {
+  auto f = _mm512_set1_pd(factor);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    auto d = _mm512_loadu_pd(dst + j);
+    _mm512_storeu_pd(dst + j, _mm512_fnmadd_pd(f, _mm512_loadu_pd(src + j), d));
+  }
+  if (j < n) {
+    __mmask8 mask = (1u << (n - j)) - 1;
+    auto d = _mm512_maskz_loadu_pd(mask, dst + j);
+    auto s = _mm512_maskz_loadu_pd(mask, src + j);
+    _mm512_mask_storeu_pd(dst + j, mask, _mm512_fnmadd_pd(f, s, d));
+  }
+}
+#endif
+
+SimdLevel detected_simd_level() {
+#ifdef DET_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::avx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::avx2;
+  }
+#endif
+  return SimdLevel::scalar;
+}
+
+static std::atomic<SimdLevel> &current_level() {
+  static std::atomic<SimdLevel> level = detected_simd_level();
+  return level;
+}
+
+SimdLevel simd_level() {
+  return current_level().load(std::memory_order_relaxed);
+}
+
+void set_simd_level(SimdLevel level) {
+  current_level() = std::min(level, detected_simd_level());
+}
+
+template <typename T>
+static void row_update_dispatch(T *dst, const T *src, T factor, std::size_t n) {
+  switch (simd_level()) {
+#ifdef DET_X86_KERNELS
+  case SimdLevel::avx512:
+    return row_update_avx512(dst, src, factor, n);
+  case SimdLevel::avx2:
+    return row_update_avx2(dst, src, factor, n);
+#endif
+  default:
+    return row_update_scalar(dst, src, factor, n);
+  }
+}
+
+void row_update(float *dst, const float *src, float factor, std::size_t n) {
+  row_update_dispatch(dst, src, factor, n);
+}
+
+void row_update(double *dst, const double *src, double factor, std::size_t n) {
+  row_update_dispatch(dst, src, factor, n);
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+enum class SimdLevel {
+  scalar,
+  avx2,
+  avx512,
+};
+
+// Best level supported by the running CPU.
+SimdLevel detected_simd_level();
+
+// Level used by the kernels below; defaults to detected_simd_level().
+// Requests above what the CPU supports are clamped.
+SimdLevel simd_level();
+void set_simd_level(SimdLevel level);
+
+// dst[j] -= factor * src[j] for j in [0, n). Unaligned pointers are fine.
+void row_update(float *dst, const float *src, float factor, std::size_t n);
+void row_update(double *dst, const double *src, double factor, std::size_t n);
\ No newline at end of file
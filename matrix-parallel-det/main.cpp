@@ -1,29 +1,9 @@
 #include "determine.hpp"
+#include "matrix_io.hpp"
 
-Matrix load_matrix_from_file(const std::string &file_name) {
-  std::ifstream file(file_name);
-
-  if (!file.is_open()) {
-    throw std::runtime_error("Unable to open file");
-  }
-
-  int rows, cols;
-  file >> rows >> cols;
-
-  std::vector<std::vector<float>> matrix(rows, std::vector<float>(cols));
-
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      file >> matrix[i][j];
-    }
-  }
-  file.close();
-
-  return Matrix(matrix);
-}
-
-int main() {
-  Matrix matrix1 = load_matrix_from_file("../data/matrix_4x4.txt");
+int main(int argc, char **argv) {
+  std::string file_name = argc > 1 ? argv[1] : "../data/matrix_4x4.txt";
+  Matrix matrix1 = load_matrix_from_file(file_name);
   size_t n;
   std::cin >> n;
   max_number_of_threads = n;
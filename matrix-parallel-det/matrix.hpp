@@ -13,52 +13,246 @@
 #include <fstream>
 #include <mutex>
 #include <ostream>
+#include <span>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <stdexcept>
+#include <memory>
+#include <utility>
 
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+    ::operator delete(ptr, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+};
+
+// Non-owning view of a matrix column: every element lies `stride` floats apart.
+template <typename T>
+class ColumnView {
+  T *_first;
+  std::size_t _size;
+  std::size_t _stride;
+public:
+  ColumnView(T *first, std::size_t size, std::size_t stride) : _first(first), _size(size), _stride(stride) {}
+
+  T &operator[](std::size_t i) const {
+    return _first[i * _stride];
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+};
+
+// Square matrix in a single row-major buffer. Rows of wide matrices start on
+// an `alignment` boundary, so `stride()` may be larger than `size()`.
+// The buffer is either owned or borrowed from an external owner such as a
+// memory-mapped file; copies always own their storage.
 class Matrix {
-  std::vector<std::vector<float>> _matrix;
+public:
+  static constexpr std::size_t alignment = 64;
+  using storage_type = std::vector<float, AlignedAllocator<float, alignment>>;
+
+private:
+  std::size_t _size = 0;
+  std::size_t _stride = 0;
+  storage_type _data;
+  std::shared_ptr<void> _external;
+  float *_begin = nullptr;
+
+  // Rows shorter than one cache line are packed: padding them would only
+  // multiply the footprint of the small minors built by cofactor expansion.
+  static std::size_t padded(std::size_t n) {
+    constexpr std::size_t lanes = alignment / sizeof(float);
+    return n <= lanes ? n : (n + lanes - 1) / lanes * lanes;
+  }
+
   Matrix() {}
 public:
-  Matrix(const int n) {
-    _matrix = std::vector(n, std::vector(n, 0.0f));
-    for (int i = 0; i < n; i++) {
-      _matrix[i][i] = 1;
+  Matrix(const int n) : _size(n), _stride(padded(n)), _data(_size * _stride, 0.0f), _begin(_data.data()) {
+    for (std::size_t i = 0; i < _size; i++) {
+      (*this)(i, i) = 1;
+    }
+  }
+
+  Matrix(const std::vector<std::vector<float>> &data) : _size(data.size()), _stride(padded(data.size())), _data(_size * _stride, 0.0f), _begin(_data.data()) {
+    for (std::size_t i = 0; i < _size; i++) {
+      // A longer row would be copied past its span into the next one.
+      if (data[i].size() != _size) {
+        throw std::invalid_argument("Matrix: rows must all have as many elements as there are rows");
+      }
+      std::ranges::copy(data[i], row(i).begin());
+    }
+  }
+
+  Matrix(const Matrix &other) : _size(other._size), _stride(other._stride), _data(_size * _stride, 0.0f), _begin(_data.data()) {
+    for (std::size_t i = 0; i < _size; i++) {
+      std::ranges::copy(other.row(i), row(i).begin());
     }
   }
 
-  Matrix(const std::vector<std::vector<float>> &data) : _matrix(data) {}
-  Matrix(std::vector<std::vector<float>> &&data) : _matrix(std::move(data)) {}
+  Matrix(Matrix &&other) noexcept
+    : _size(std::exchange(other._size, 0)), _stride(std::exchange(other._stride, 0)), _data(std::move(other._data)),
+      _external(std::move(other._external)), _begin(std::exchange(other._begin, nullptr)) {}
+
+  Matrix & operator=(Matrix other) noexcept {
+    std::swap(_size, other._size);
+    std::swap(_stride, other._stride);
+    std::swap(_data, other._data);
+    std::swap(_external, other._external);
+    std::swap(_begin, other._begin);
+    return *this;
+  }
+
+  static Matrix zeros(std::size_t n) {
+    Matrix ret;
+    ret._size = n;
+    ret._stride = padded(n);
+    ret._data.assign(n * ret._stride, 0.0f);
+    ret._begin = ret._data.data();
+    return ret;
+  }
+
+  // Wraps `n` rows of `stride` floats starting at `data` without copying.
+  // `owner` keeps the memory alive for as long as the matrix uses it.
+  static Matrix from_external(float *data, std::size_t n, std::size_t stride, std::shared_ptr<void> owner) {
+    assert(stride >= n);
+    Matrix ret;
+    ret._size = n;
+    ret._stride = stride;
+    ret._external = std::move(owner);
+    ret._begin = data;
+    return ret;
+  }
+
+  bool owns_data() const {
+    return !_external;
+  }
+
+  float &operator()(std::size_t i, std::size_t j) {
+    return _begin[i * _stride + j];
+  }
+
+  float operator()(std::size_t i, std::size_t j) const {
+    return _begin[i * _stride + j];
+  }
+
+  std::span<float> row(std::size_t i) {
+    return {_begin + i * _stride, _size};
+  }
+
+  std::span<const float> row(std::size_t i) const {
+    return {_begin + i * _stride, _size};
+  }
+
+  ColumnView<float> col(std::size_t j) {
+    return {_begin + j, _size, _stride};
+  }
+
+  ColumnView<const float> col(std::size_t j) const {
+    return {_begin + j, _size, _stride};
+  }
 
   Matrix minor(std::size_t row, std::size_t col) const {
-    std::size_t n = _matrix.size();
-    std::vector matrix(n - 1, std::vector(n - 1, 0.0f));
+    Matrix ret = zeros(_size - 1);
 
     std::size_t i_idx = 0;
-    for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t i = 0; i < _size; i++) {
       if (i == row) {
         continue;
       }
 
-      std::size_t j_idx = 0;
-      for (std::size_t j = 0; j < n; j++) {
-        if (j == col) {
-          continue;
-        }
-        matrix[i_idx][j_idx] = _matrix[i][j];
-        j_idx++;
-      }
+      auto src = this->row(i);
+      auto dst = ret.row(i_idx);
+      std::copy(src.begin(), src.begin() + col, dst.begin());
+      std::copy(src.begin() + col + 1, src.end(), dst.begin() + col);
       i_idx++;
     }
 
-    Matrix ret;
-    ret._matrix = std::move(matrix);
     return ret;
   }
 
-  const std::vector<std::vector<float>> & data() const {
-    return _matrix;
+  float *data() {
+    return _begin;
+  }
+
+  const float *data() const {
+    return _begin;
+  }
+
+  std::size_t stride() const {
+    return _stride;
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+};
+
+// Minor of a Matrix described by the parent rows and columns it keeps.
+// Taking a minor of a view only rewrites these index arrays, so cofactor
+// expansion can recurse without touching the heap.
+class MinorView {
+public:
+  static constexpr std::size_t max_size = 32;
+
+private:
+  const Matrix *_matrix;
+  std::size_t _size;
+  std::array<std::uint8_t, max_size> _rows;
+  std::array<std::uint8_t, max_size> _cols;
+
+  MinorView(const Matrix *matrix, std::size_t size) : _matrix(matrix), _size(size) {}
+public:
+  // Index arrays are uint8 of length max_size; cofactor expansion beyond
+  // that is out of reach anyway.
+  MinorView(const Matrix &matrix) : _matrix(&matrix), _size(matrix.size()) {
+    if (_size > max_size) {
+      throw std::invalid_argument("MinorView: matrix larger than max_size");
+    }
+    for (std::size_t i = 0; i < _size; i++) {
+      _rows[i] = i;
+      _cols[i] = i;
+    }
+  }
+
+  float operator()(std::size_t i, std::size_t j) const {
+    return (*_matrix)(_rows[i], _cols[j]);
+  }
+
+  MinorView minor(std::size_t row, std::size_t col) const {
+    MinorView ret(_matrix, _size - 1);
+    std::copy(_rows.begin(), _rows.begin() + row, ret._rows.begin());
+    std::copy(_rows.begin() + row + 1, _rows.begin() + _size, ret._rows.begin() + row);
+    std::copy(_cols.begin(), _cols.begin() + col, ret._cols.begin());
+    std::copy(_cols.begin() + col + 1, _cols.begin() + _size, ret._cols.begin() + col);
+    return ret;
   }
 
   std::size_t size() const {
-    return _matrix.size();
+    return _size;
   }
-};
\ No newline at end of file
+};
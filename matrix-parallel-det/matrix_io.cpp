@@ -0,0 +1,212 @@
+#include "matrix_io.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Read-only view of a whole file; the mapping lives as long as the last
+// Matrix that borrows it.
+class FileMapping {
+  void *_data = MAP_FAILED;
+  std::size_t _size = 0;
+public:
+  FileMapping(const std::string &file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Unable to open file");
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+    _size = st.st_size;
+
+    if (_size != 0) {
+      _data = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (_size != 0 && _data == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+  }
+
+  ~FileMapping() {
+    if (_data != MAP_FAILED) {
+      ::munmap(_data, _size);
+    }
+  }
+
+  FileMapping(const FileMapping &) = delete;
+  FileMapping & operator=(const FileMapping &) = delete;
+
+  char *data() const {
+    return _size == 0 ? nullptr : static_cast<char *>(_data);
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+};
+
+bool is_binary_header(const char *data, std::size_t size) {
+  return size >= sizeof(BinaryMatrixHeader) &&
+         std::memcmp(data, BinaryMatrixHeader::expected_magic, sizeof(BinaryMatrixHeader::expected_magic)) == 0;
+}
+
+class TextParser {
+  const char *_pos;
+  const char *_end;
+public:
+  TextParser(const char *begin, const char *end) : _pos(begin), _end(end) {}
+
+  template <typename T>
+  T next() {
+    while (_pos != _end && (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t')) {
+      _pos++;
+    }
+
+    T value;
+    auto [ptr, ec] = std::from_chars(_pos, _end, value);
+    if (ec != std::errc()) {
+      throw std::runtime_error("Malformed matrix file");
+    }
+    _pos = ptr;
+    return value;
+  }
+};
+
+Matrix parse_text(const char *begin, const char *end) {
+  TextParser parser(begin, end);
+  auto rows = parser.next<int>();
+  auto cols = parser.next<int>();
+
+  if (rows != cols) {
+    throw std::runtime_error("Matrix is not square");
+  }
+  if (rows < 0) {
+    throw std::runtime_error("Malformed matrix file");
+  }
+
+  auto matrix = Matrix::zeros(rows);
+  for (int i = 0; i < rows; ++i) {
+    for (auto &value : matrix.row(i)) {
+      value = parser.next<float>();
+    }
+  }
+
+  return matrix;
+}
+
+Matrix from_mapping(std::shared_ptr<FileMapping> mapping) {
+  BinaryMatrixHeader header;
+  std::memcpy(&header, mapping->data(), sizeof(header));
+
+  if (header.version != BinaryMatrixHeader::current_version) {
+    throw std::runtime_error("Unsupported matrix file version");
+  }
+  if (header.rows != header.cols) {
+    throw std::runtime_error("Matrix is not square");
+  }
+
+  std::size_t element_size = header.dtype == BinaryMatrixHeader::float32 ? sizeof(float)
+                           : header.dtype == BinaryMatrixHeader::float64 ? sizeof(double)
+                           : 0;
+  if (element_size == 0) {
+    throw std::runtime_error("Unsupported matrix element type");
+  }
+  if (header.alignment != Matrix::alignment) {
+    throw std::runtime_error("Unsupported matrix file alignment");
+  }
+  // The fields come straight from the file, so each bound is checked on its
+  // own rather than through a product that could wrap. stride >= cols = rows
+  // keeps the division well defined when rows != 0.
+  std::size_t size = mapping->size();
+  if (header.stride < header.cols || header.data_offset < sizeof(header) || header.data_offset > size ||
+      (header.rows != 0 && header.rows > (size - header.data_offset) / element_size / header.stride)) {
+    throw std::runtime_error("Malformed matrix file");
+  }
+
+  std::size_t n = header.rows;
+  char *first = mapping->data() + header.data_offset;
+
+  if (header.dtype == BinaryMatrixHeader::float32 && reinterpret_cast<std::uintptr_t>(first) % alignof(float) == 0) {
+    return Matrix::from_external(reinterpret_cast<float *>(first), n, header.stride, std::move(mapping));
+  }
+
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    auto row = matrix.row(i);
+    for (std::size_t j = 0; j < n; j++) {
+      char *element = first + (i * header.stride + j) * element_size;
+      if (header.dtype == BinaryMatrixHeader::float32) {
+        float value;
+        std::memcpy(&value, element, sizeof(value));
+        row[j] = value;
+      } else {
+        double value;
+        std::memcpy(&value, element, sizeof(value));
+        row[j] = static_cast<float>(value);
+      }
+    }
+  }
+  return matrix;
+}
+
+}
+
+Matrix load_matrix_text(const std::string &file_name) {
+  FileMapping mapping(file_name);
+  return parse_text(mapping.data(), mapping.data() + mapping.size());
+}
+
+Matrix load_matrix_binary(const std::string &file_name) {
+  auto mapping = std::make_shared<FileMapping>(file_name);
+  if (!is_binary_header(mapping->data(), mapping->size())) {
+    throw std::runtime_error("Not a binary matrix file");
+  }
+  return from_mapping(std::move(mapping));
+}
+
+void save_matrix_binary(const Matrix &matrix, const std::string &file_name) {
+  std::ofstream file(file_name, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Unable to open file");
+  }
+
+  BinaryMatrixHeader header{};
+  std::memcpy(header.magic, BinaryMatrixHeader::expected_magic, sizeof(header.magic));
+  header.version = BinaryMatrixHeader::current_version;
+  header.rows = matrix.size();
+  header.cols = matrix.size();
+  header.dtype = BinaryMatrixHeader::float32;
+  header.alignment = Matrix::alignment;
+  header.stride = matrix.stride();
+  header.data_offset = (sizeof(header) + Matrix::alignment - 1) / Matrix::alignment * Matrix::alignment;
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  std::vector<char> padding(header.data_offset - sizeof(header), 0);
+  file.write(padding.data(), padding.size());
+  file.write(reinterpret_cast<const char *>(matrix.data()), matrix.size() * matrix.stride() * sizeof(float));
+
+  if (!file) {
+    throw std::runtime_error("Unable to write matrix file");
+  }
+}
+
+Matrix load_matrix_from_file(const std::string &file_name) {
+  auto mapping = std::make_shared<FileMapping>(file_name);
+  if (is_binary_header(mapping->data(), mapping->size())) {
+    return from_mapping(std::move(mapping));
+  }
+  return parse_text(mapping->data(), mapping->data() + mapping->size());
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "matrix.hpp"
+
+#include <cstdint>
+#include <string>
+
+// On-disk layout of a binary matrix file. The header is followed by
+// padding up to `data_offset`, then `rows` rows of `stride` elements each.
+// Rows start on `alignment` byte boundaries, so a float32 file written with
+// the Matrix stride maps straight onto Matrix storage.
+struct BinaryMatrixHeader {
+  static constexpr char expected_magic[4] = {'D', 'M', 'A', 'T'};
+  static constexpr std::uint32_t current_version = 1;
+
+  enum DType : std::uint32_t {
+    float32 = 0,
+    float64 = 1,
+  };
+
+  char magic[4];
+  std::uint32_t version;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint32_t dtype;
+  std::uint32_t alignment;
+  std::uint64_t stride;
+  std::uint64_t data_offset;
+};
+
+// Text format: "rows cols" followed by the elements in row-major order.
+// Parsed with std::from_chars over the whole file in one buffer.
+Matrix load_matrix_text(const std::string &file_name);
+
+// Maps a binary file with mmap. float32 data is used in place (private,
+// copy-on-write mapping); float64 data is converted into owned storage.
+Matrix load_matrix_binary(const std::string &file_name);
+void save_matrix_binary(const Matrix &matrix, const std::string &file_name);
+
+// Picks the binary or text loader by looking at the file's magic bytes.
+Matrix load_matrix_from_file(const std::string &file_name);
\ No newline at end of file
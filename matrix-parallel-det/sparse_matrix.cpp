@@ -0,0 +1,213 @@
+#include "sparse_matrix.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+SparseMatrix SparseMatrix::from_entries(std::size_t n, std::vector<Entry> entries) {
+  std::ranges::sort(entries, [](const Entry &a, const Entry &b) {
+    return a.col != b.col ? a.col < b.col : a.row < b.row;
+  });
+
+  SparseMatrix result;
+  result._size = n;
+  result._col_start.assign(n + 1, 0);
+  result._row_index.reserve(entries.size());
+  result._values.reserve(entries.size());
+
+  for (std::size_t k = 0; k < entries.size();) {
+    auto [row, col, value] = entries[k];
+    for (k++; k < entries.size() && entries[k].row == row && entries[k].col == col; k++) {
+      value += entries[k].value;
+    }
+    if (value != 0) {
+      result._row_index.push_back(row);
+      result._values.push_back(value);
+      result._col_start[col + 1]++;
+    }
+  }
+
+  for (std::size_t j = 0; j < n; j++) {
+    result._col_start[j + 1] += result._col_start[j];
+  }
+  return result;
+}
+
+SparseMatrix SparseMatrix::from_dense(const Matrix &matrix) {
+  std::size_t n = matrix.size();
+  SparseMatrix result;
+  result._size = n;
+  result._col_start.assign(n + 1, 0);
+
+  for (std::size_t j = 0; j < n; j++) {
+    for (std::size_t i = 0; i < n; i++) {
+      if (matrix(i, j) != 0) {
+        result._row_index.push_back(i);
+        result._values.push_back(matrix(i, j));
+      }
+    }
+    result._col_start[j + 1] = result._values.size();
+  }
+  return result;
+}
+
+Matrix SparseMatrix::to_dense() const {
+  auto result = Matrix::zeros(_size);
+  for (std::size_t j = 0; j < _size; j++) {
+    auto rows = column_rows(j);
+    auto values = column_values(j);
+    for (std::size_t p = 0; p < rows.size(); p++) {
+      result(rows[p], j) = values[p];
+    }
+  }
+  return result;
+}
+
+SparseMatrix SparseMatrix::transpose() const {
+  SparseMatrix result;
+  result._size = _size;
+  result._col_start.assign(_size + 1, 0);
+  result._row_index.resize(nonzeros());
+  result._values.resize(nonzeros());
+
+  for (auto row : _row_index) {
+    result._col_start[row + 1]++;
+  }
+  for (std::size_t i = 0; i < _size; i++) {
+    result._col_start[i + 1] += result._col_start[i];
+  }
+
+  // Scanning columns in order keeps every output column sorted.
+  std::vector<std::size_t> next(result._col_start.begin(), result._col_start.end() - 1);
+  for (std::size_t j = 0; j < _size; j++) {
+    for (std::size_t p = _col_start[j]; p < _col_start[j + 1]; p++) {
+      auto q = next[_row_index[p]]++;
+      result._row_index[q] = j;
+      result._values[q] = _values[p];
+    }
+  }
+  return result;
+}
+
+// Eliminating variable p turns it into an element whose members are the
+// variables p was connected to, directly or through earlier elements; those
+// elements are absorbed into the new one. Variables only keep the direct
+// neighbours that are not covered by one of their elements, so the graph
+// never grows beyond the original pattern plus one list per element.
+std::vector<std::size_t> minimum_degree_ordering(const SparseMatrix &matrix) {
+  std::size_t n = matrix.size();
+  std::vector<std::vector<std::size_t>> variables(n);
+  for (std::size_t j = 0; j < n; j++) {
+    for (auto i : matrix.column_rows(j)) {
+      if (i != j) {
+        variables[i].push_back(j);
+        variables[j].push_back(i);
+      }
+    }
+  }
+
+  using Candidate = std::pair<std::size_t, std::size_t>;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue;
+  std::vector<std::size_t> degree(n);
+  for (std::size_t i = 0; i < n; i++) {
+    std::ranges::sort(variables[i]);
+    auto [first, last] = std::ranges::unique(variables[i]);
+    variables[i].erase(first, last);
+    degree[i] = variables[i].size();
+    queue.emplace(degree[i], i);
+  }
+
+  std::vector<std::vector<std::size_t>> elements(n);
+  std::vector<std::vector<std::size_t>> members(n);
+  std::vector<char> eliminated(n, 0);
+  std::vector<char> element_alive(n, 0);
+  // Stamps avoid clearing the marker arrays between steps.
+  std::vector<std::size_t> mark(n, 0);
+  std::vector<std::size_t> weight_mark(n, 0);
+  std::vector<std::size_t> weight(n, 0);
+
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  std::size_t step = 0;
+  while (order.size() < n) {
+    auto [d, p] = queue.top();
+    queue.pop();
+    if (eliminated[p] || d != degree[p]) {
+      // Stale queue entry.
+      continue;
+    }
+    step++;
+    eliminated[p] = 1;
+    order.push_back(p);
+
+    std::vector<std::size_t> pattern;
+    mark[p] = step;
+    auto add = [&](std::size_t v) {
+      if (!eliminated[v] && mark[v] != step) {
+        mark[v] = step;
+        pattern.push_back(v);
+      }
+    };
+    for (auto v : variables[p]) {
+      add(v);
+    }
+    for (auto e : elements[p]) {
+      if (element_alive[e]) {
+        for (auto v : members[e]) {
+          add(v);
+        }
+        element_alive[e] = 0;
+        std::vector<std::size_t>().swap(members[e]);
+      }
+    }
+    std::vector<std::size_t>().swap(variables[p]);
+    std::vector<std::size_t>().swap(elements[p]);
+
+    // weight[e] = |members(e) \ pattern| for every element next to the
+    // pattern, computed in one pass over the pattern as in AMD.
+    for (auto i : pattern) {
+      for (auto e : elements[i]) {
+        if (!element_alive[e]) {
+          continue;
+        }
+        if (weight_mark[e] != step) {
+          weight_mark[e] = step;
+          weight[e] = members[e].size();
+        }
+        weight[e]--;
+      }
+    }
+
+    std::size_t remaining = n - order.size();
+    for (auto i : pattern) {
+      std::size_t external = 0;
+      std::erase_if(elements[i], [&](std::size_t e) {
+        if (!element_alive[e]) {
+          return true;
+        }
+        if (weight[e] == 0) {
+          // Covered by the new element: absorb it.
+          element_alive[e] = 0;
+          std::vector<std::size_t>().swap(members[e]);
+          return true;
+        }
+        external += weight[e];
+        return false;
+      });
+      elements[i].push_back(p);
+
+      std::erase_if(variables[i], [&](std::size_t v) {
+        return eliminated[v] || mark[v] == step;
+      });
+
+      degree[i] = std::min(remaining - 1, variables[i].size() + pattern.size() - 1 + external);
+      queue.emplace(degree[i], i);
+    }
+
+    element_alive[p] = 1;
+    members[p] = std::move(pattern);
+  }
+
+  return order;
+}
\ No newline at end of file
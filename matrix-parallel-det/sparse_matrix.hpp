@@ -0,0 +1,59 @@
+#pragma once
+
+#include "matrix.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Square sparse matrix in compressed sparse column (CSC) form: the row
+// indices and values of column j are stored at [col_start[j],
+// col_start[j + 1]), sorted by row. The CSC arrays of the transpose are
+// the CSR arrays of the matrix itself, so transpose() doubles as the CSR
+// view.
+class SparseMatrix {
+  std::size_t _size = 0;
+  std::vector<std::size_t> _col_start = {0};
+  std::vector<std::size_t> _row_index;
+  std::vector<float> _values;
+public:
+  struct Entry {
+    std::size_t row;
+    std::size_t col;
+    float value;
+  };
+
+  SparseMatrix() = default;
+
+  // Duplicate entries are summed and explicit zeros are dropped.
+  static SparseMatrix from_entries(std::size_t n, std::vector<Entry> entries);
+  static SparseMatrix from_dense(const Matrix &matrix);
+
+  Matrix to_dense() const;
+  SparseMatrix transpose() const;
+
+  std::span<const std::size_t> column_rows(std::size_t j) const {
+    return {_row_index.data() + _col_start[j], _row_index.data() + _col_start[j + 1]};
+  }
+
+  std::span<const float> column_values(std::size_t j) const {
+    return {_values.data() + _col_start[j], _values.data() + _col_start[j + 1]};
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  std::size_t nonzeros() const {
+    return _values.size();
+  }
+
+  double density() const {
+    return _size == 0 ? 0 : double(nonzeros()) / (double(_size) * double(_size));
+  }
+};
+
+// Fill-reducing elimination order for the pattern of A + A^T: minimum
+// degree on the quotient graph with AMD's approximate external degrees and
+// element absorption. Returns the columns in elimination order.
+std::vector<std::size_t> minimum_degree_ordering(const SparseMatrix &matrix);
\ No newline at end of file
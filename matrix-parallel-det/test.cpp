@@ -1,7 +1,13 @@
 #include "determine.hpp"
+#include "matrix_io.hpp"
+#include "determinant_tracker.hpp"
 
 #include <print>
 #include <complex>
+#include <random>
+#include <filesystem>
+#include <numeric>
+#include <algorithm>
 
 static bool test_low_det() {
   size_t max_size = 10;
@@ -152,6 +158,554 @@ static bool test_high_swapped() {
   return true;
 }
 
+static bool test_minor_view() {
+  std::vector<std::vector<float>> data = {
+    {1, 2, 3, 4},
+    {5, 6, 7, 8},
+    {9, 10, 11, 12},
+    {13, 14, 15, 16}
+  };
+  Matrix matrix(std::move(data));
+
+  auto copy = matrix.minor(1, 2).minor(0, 0);
+  auto view = MinorView(matrix).minor(1, 2).minor(0, 0);
+
+  if (view.size() != copy.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < copy.size(); i++) {
+    for (std::size_t j = 0; j < copy.size(); j++) {
+      if (view(i, j) != copy(i, j)) {
+        return false;
+      }
+    }
+  }
+
+  try {
+    MinorView(Matrix::zeros(MinorView::max_size + 1));
+    return false;
+  } catch (const std::invalid_argument &) {
+  }
+
+  try {
+    Matrix(std::vector<std::vector<float>> {{1, 2, 3}, {4, 5}, {6}});
+    return false;
+  } catch (const std::invalid_argument &) {
+  }
+
+  return true;
+}
+
+static bool test_gauss_det() {
+  std::vector<std::pair<std::vector<std::vector<float>>, double>> cases = {
+    {{{1, 5, 6, 7}, {0, 2, 8, 9}, {0, 0, 3, 4}, {0, 0, 0, 4}}, 24},
+    {{{1, 3, 5}, {4, 0, 1}, {2, 1, 0}}, 25},
+    {{{0, 0, 0, 1}, {0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}}, -1},
+    {{{1, 11, 43, 87}, {3, 0, 1, 4}, {5, 47, 0, 1}, {11, 12, 3, 4}}, -53016},
+    {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, 0},
+  };
+
+  auto saved_level = simd_level();
+  bool passed = true;
+  for (auto level : {SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512}) {
+    set_simd_level(level);
+    for (auto &&[data, det] : cases) {
+      Matrix matrix(data);
+      if (std::fabs(det_gauss<double>(matrix) - det) > 1e-9 * std::max(1.0, std::fabs(det))) {
+        passed = false;
+      }
+      if (std::fabs(det_gauss<float>(matrix) - det) > 1e-4 * std::max(1.0, std::fabs(det))) {
+        passed = false;
+      }
+    }
+  }
+  set_simd_level(saved_level);
+
+  return passed;
+}
+
+// data/ is not tracked, so the matrices are generated here and go through
+// the text loader the same way the data files would.
+static bool test_gauss_data_files() {
+  std::mt19937 gen(29);
+  std::uniform_int_distribution<int> dist(-9, 9);
+  auto file_name = (std::filesystem::temp_directory_path() / "det_test_gauss.txt").string();
+
+  for (int n = 3; n <= 10; n++) {
+    {
+      std::ofstream file(file_name);
+      file << n << ' ' << n << '\n';
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          file << dist(gen) << ' ';
+        }
+        file << '\n';
+      }
+    }
+
+    auto matrix = load_matrix_from_file(file_name);
+    double expected = det_low(matrix, 1);
+    double det_f = det_gauss<float>(matrix);
+    double det_d = det_gauss<double>(matrix);
+
+    if (matrix.size() != std::size_t(n) || expected == 0) {
+      std::filesystem::remove(file_name);
+      return false;
+    }
+    if (std::fabs(det_d - expected) > 1e-5 * std::fabs(expected) ||
+        std::fabs(det_f - det_d) > 1e-4 * std::fabs(det_d)) {
+      std::filesystem::remove(file_name);
+      return false;
+    }
+  }
+
+  std::filesystem::remove(file_name);
+  return true;
+}
+
+// Product of row norms: bounds |det| and sets the scale of its rounding error.
+static double hadamard_bound(const Matrix &matrix) {
+  double bound = 1;
+  for (std::size_t i = 0; i < matrix.size(); i++) {
+    double norm = 0;
+    for (auto value : matrix.row(i)) {
+      norm += double(value) * value;
+    }
+    bound *= std::sqrt(norm);
+  }
+  return bound;
+}
+
+static bool test_det_batch() {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-9, 9);
+
+  std::vector<Matrix> matrices;
+  for (int i = 0; i < 5000; i++) {
+    // Long run of 4x4 matrices followed by mixed sizes, including ones
+    // without an unrolled kernel.
+    std::size_t n = i < 4500 ? 4 : 1 + i % 10;
+    auto matrix = Matrix::zeros(n);
+    for (std::size_t r = 0; r < n; r++) {
+      for (auto &value : matrix.row(r)) {
+        value = dist(gen);
+      }
+    }
+    matrices.push_back(std::move(matrix));
+  }
+
+  std::vector<float> results(matrices.size());
+  det_batch(matrices, results);
+
+  for (std::size_t i = 0; i < matrices.size(); i++) {
+    double expected = det_gauss<double>(matrices[i]);
+    if (std::fabs(results[i] - expected) > 1e-5 * hadamard_bound(matrices[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool test_blocked_lu() {
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> dist(-1, 1);
+
+  std::size_t n = 203;
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto &value : matrix.row(i)) {
+      value = dist(gen);
+    }
+  }
+
+  double expected = det_gauss<double>(matrix);
+  for (std::size_t block_size : {1, 16, 48, 256}) {
+    for (std::size_t threads : {1, 3}) {
+      if (std::fabs(det_blocked<double>(matrix, block_size, threads) - expected) > 1e-9 * std::fabs(expected)) {
+        return false;
+      }
+    }
+  }
+
+  for (auto &&[data, det] : std::vector<std::pair<std::vector<std::vector<float>>, float>> {
+    {{{1, 11, 43, 87}, {3, 0, 1, 4}, {5, 47, 0, 1}, {11, 12, 3, 4}}, -53016},
+    {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, 0},
+  }) {
+    if (std::fabs(det_blocked<double>(Matrix(data), 2, 2) - det) > 1e-9 * std::max(1.0f, std::fabs(det))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool test_thread_pool() {
+  // Resizing the shared pool must leave the one still held intact.
+  auto first = shared_pool(2);
+  auto second = shared_pool(3);
+  if (first->size() != 2 || second->size() != 3) {
+    return false;
+  }
+
+  std::atomic<int> done = 0;
+  {
+    TaskGroup group(*first);
+    for (int i = 0; i < 100; i++) {
+      group.run([&done]() {
+        done++;
+      });
+    }
+  }
+  if (done != 100) {
+    return false;
+  }
+
+  // A throwing task still finishes, and wait() rethrows its exception.
+  TaskGroup group(*second);
+  for (int i = 0; i < 10; i++) {
+    group.run([&done, i]() {
+      if (i == 3) {
+        throw std::runtime_error("task failed");
+      }
+      done++;
+    });
+  }
+  try {
+    group.wait();
+    return false;
+  } catch (const std::runtime_error &) {
+  }
+
+  return done == 109;
+}
+
+static bool test_sparse_det() {
+  for (auto &&[data, det] : std::vector<std::pair<std::vector<std::vector<float>>, double>> {
+    {{{1, 11, 43, 87}, {3, 0, 1, 4}, {5, 47, 0, 1}, {11, 12, 3, 4}}, -53016},
+    {{{0, 1, 0}, {0, 0, 2}, {3, 0, 0}}, 6},
+    {{{0, 1}, {1, 0}}, -1},
+    {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, 0},
+    // Zero diagonal entries that must not be taken as pivots.
+    {{{2, 0, -1}, {-1, 0, 1}, {1, 2, 0}}, -2},
+    {{{0, 3, 1}, {2, 0, 0}, {1, 1, 0}}, 2},
+  }) {
+    auto sparse = SparseMatrix::from_dense(Matrix(data));
+    if (std::fabs(det_sparse(sparse).value() - det) > 1e-9 * std::max(1.0, std::fabs(det))) {
+      return false;
+    }
+  }
+
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<float> dist(-1, 1);
+  std::bernoulli_distribution present(0.03);
+
+  std::size_t n = 150;
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      if (i == j || present(gen)) {
+        matrix(i, j) = dist(gen);
+      }
+    }
+  }
+
+  auto sparse = SparseMatrix::from_dense(matrix);
+  if (sparse.transpose().transpose().to_dense().row(7)[0] != matrix(7, 0)) {
+    return false;
+  }
+
+  auto order = minimum_degree_ordering(sparse);
+  std::ranges::sort(order);
+  for (std::size_t i = 0; i < n; i++) {
+    if (order[i] != i) {
+      return false;
+    }
+  }
+
+  double expected = det_gauss<double>(matrix);
+  if (std::fabs(det_sparse(sparse).value() - expected) > 1e-9 * std::fabs(expected) ||
+      std::fabs(det_auto(matrix) - expected) > 1e-9 * std::fabs(expected)) {
+    return false;
+  }
+
+  // Small integer matrices with zero diagonals force off-diagonal pivots;
+  // the exact determinant is the reference.
+  std::uniform_int_distribution<int> digit(-9, 9);
+  std::bernoulli_distribution filled(0.5);
+  for (int i = 0; i < 2000; i++) {
+    std::size_t size = 3 + i % 6;
+    auto small = Matrix::zeros(size);
+    for (std::size_t r = 0; r < size; r++) {
+      for (std::size_t c = 0; c < size; c++) {
+        if (r != c && filled(gen)) {
+          small(r, c) = float(digit(gen));
+        }
+      }
+    }
+    double exact = double(det_exact(small).to_int64());
+    if (std::fabs(det_sparse(SparseMatrix::from_dense(small)).value() - exact) >
+        1e-9 * std::max(1.0, hadamard_bound(small))) {
+      return false;
+    }
+  }
+
+  // Below det_sparse_density, so det_auto takes the sparse path: a
+  // permutation of nonzeros plus a few extra entries.
+  n = 512;
+  auto scattered = Matrix::zeros(n);
+  std::vector<std::size_t> permutation(n);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::ranges::shuffle(permutation, gen);
+  std::uniform_real_distribution<float> magnitude(1, 2);
+  for (std::size_t i = 0; i < n; i++) {
+    scattered(i, permutation[i]) = present(gen) ? -magnitude(gen) : magnitude(gen);
+  }
+  std::uniform_int_distribution<std::size_t> index(0, n - 1);
+  for (std::size_t i = 0; i < n / 4; i++) {
+    scattered(index(gen), index(gen)) = dist(gen);
+  }
+  std::size_t nonzeros = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto value : scattered.row(i)) {
+      nonzeros += value != 0;
+    }
+  }
+  if (n < det_sparse_min_size || double(nonzeros) > det_sparse_density * double(n) * double(n)) {
+    return false;
+  }
+  expected = det_gauss<double>(scattered);
+  return expected != 0 && std::fabs(det_auto(scattered) - expected) <= 1e-9 * std::fabs(expected);
+}
+
+static bool test_determinant_tracker() {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(-9, 9);
+  std::uniform_int_distribution<std::size_t> index(0, 39);
+
+  std::size_t n = 40;
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto &value : matrix.row(i)) {
+      value = dist(gen);
+    }
+  }
+
+  DeterminantTracker tracker(matrix, 16);
+  std::vector<float> line(n), other(n);
+  for (int step = 0; step < 100; step++) {
+    for (std::size_t k = 0; k < n; k++) {
+      line[k] = dist(gen);
+      other[k] = k == std::size_t(step) % n ? 1 : 0;
+    }
+
+    auto target = index(gen);
+    switch (step % 3) {
+    case 0:
+      tracker.replace_row(target, line);
+      std::ranges::copy(line, matrix.row(target).begin());
+      break;
+    case 1:
+      tracker.replace_column(target, line);
+      for (std::size_t i = 0; i < n; i++) {
+        matrix(i, target) = line[i];
+      }
+      break;
+    default:
+      // u e_k^T with small integers keeps the float matrix exact.
+      tracker.rank_one_update(line, other);
+      for (std::size_t i = 0; i < n; i++) {
+        matrix(i, std::size_t(step) % n) += line[i];
+      }
+      break;
+    }
+
+    double expected = det_gauss<double>(matrix);
+    if (std::fabs(tracker.determinant() - expected) > 1e-8 * std::fabs(expected)) {
+      return false;
+    }
+  }
+
+  // A duplicated row makes the matrix singular up to rounding; replacing
+  // it recovers.
+  double expected = det_gauss<double>(matrix);
+  auto saved = std::vector<float>(matrix.row(1).begin(), matrix.row(1).end());
+  tracker.replace_row(1, matrix.row(0));
+  if (std::fabs(tracker.determinant()) > 1e-8 * std::fabs(expected)) {
+    return false;
+  }
+  tracker.replace_row(1, saved);
+  return std::fabs(tracker.determinant() - expected) <= 1e-8 * std::fabs(expected);
+}
+
+static bool test_big_integer() {
+  std::mt19937_64 gen(11);
+  for (int iter = 0; iter < 200; iter++) {
+    BigInteger a = static_cast<std::int64_t>(gen() >> 1) - (std::int64_t(1) << 62);
+    BigInteger b = static_cast<std::int64_t>(gen() >> 20) + 1;
+    for (int k = 0; k < iter % 5; k++) {
+      a *= static_cast<std::int64_t>(gen() >> 2) - (std::int64_t(1) << 60);
+      b *= static_cast<std::int64_t>(gen() >> 3) + 1;
+    }
+
+    auto product = a * b;
+    if (product / b != a || product / a != b || product - a * b != BigInteger(0)) {
+      return false;
+    }
+  }
+
+  BigInteger big = 1;
+  for (int i = 0; i < 3; i++) {
+    big *= 1'000'000'000'000;
+  }
+  if (big.to_string() != "1000000000000000000000000000000000000" || (-big + 1).to_string() != "-999999999999999999999999999999999999") {
+    return false;
+  }
+  if (BigInteger(INT64_MIN).to_int64() != INT64_MIN || BigInteger(-42).to_string() != "-42") {
+    return false;
+  }
+
+  return true;
+}
+
+static bool test_exact_det() {
+  std::vector<std::pair<std::vector<std::vector<float>>, std::int64_t>> cases = {
+    {{{1, 5, 6, 7}, {0, 2, 8, 9}, {0, 0, 3, 4}, {0, 0, 0, 4}}, 24},
+    {{{1, 3, 5}, {4, 0, 1}, {2, 1, 0}}, 25},
+    {{{0, 0, 0, 1}, {0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}}, -1},
+    {{{1, 11, 43, 87}, {3, 0, 1, 4}, {5, 47, 0, 1}, {11, 12, 3, 4}}, -53016},
+    {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, 0},
+    // |det| > 2^24, so no float engine can return it exactly.
+    {{
+      {79, 32, 94, 45, 88, 94, 83, 67},
+      {3, 59, 99, 31, 83, 6, 20, 14},
+      {47, 60, 31, 48, 69, 13, 73, 31},
+      {1, 93, 27, 52, 35, 23, 98, 49},
+      {20, 97, 9, 17, 79, 79, 56, 16},
+      {16, 0, 0, 26, 99, 27, 21, 21},
+      {37, 40, 25, 69, 86, 80, 26, 23},
+      {88, 25, 49, 38, 2, 46, 53, 21},
+    }, 112606941142439},
+  };
+
+  for (auto &&[data, det] : cases) {
+    if (det_exact(Matrix(data)) != BigInteger(det)) {
+      return false;
+    }
+  }
+
+  // Lower triangular with 1000 on the diagonal and its rows reversed:
+  // det = -(1000^11), far outside int64_t, with row swaps on the way.
+  std::size_t n = 11;
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < i; j++) {
+      matrix(n - 1 - i, j) = float((i * 7 + j * 3) % 19) - 9;
+    }
+    matrix(n - 1 - i, i) = 1000;
+  }
+  if (det_exact(matrix).to_string() != "-1" + std::string(33, '0')) {
+    return false;
+  }
+
+  try {
+    det_exact(Matrix(std::vector<std::vector<float>> {{0.5f}}));
+    return false;
+  } catch (const std::invalid_argument &) {
+  }
+
+  return true;
+}
+
+static bool test_binary_round_trip() {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dist(-1, 1);
+
+  std::size_t n = 21;
+  auto matrix = Matrix::zeros(n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto &value : matrix.row(i)) {
+      value = dist(gen);
+    }
+  }
+
+  auto file_name = (std::filesystem::temp_directory_path() / "det_test_matrix.bin").string();
+  save_matrix_binary(matrix, file_name);
+  auto mapped = load_matrix_from_file(file_name);
+  auto copy = mapped;
+  std::filesystem::remove(file_name);
+
+  if (mapped.owns_data() || !copy.owns_data() || mapped.size() != n) {
+    return false;
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    if (!std::ranges::equal(mapped.row(i), matrix.row(i)) || !std::ranges::equal(copy.row(i), matrix.row(i))) {
+      return false;
+    }
+  }
+
+  // Headers whose sizes wrap in 64 bits or disagree with the writer must be
+  // rejected before anything is read past the mapping.
+  auto corrupt = [&](auto &&change) {
+    save_matrix_binary(matrix, file_name);
+    BinaryMatrixHeader header;
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+    change(header);
+    {
+      std::fstream out(file_name, std::ios::binary | std::ios::in | std::ios::out);
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+    try {
+      load_matrix_binary(file_name);
+      return false;
+    } catch (const std::runtime_error &) {
+      return true;
+    }
+  };
+  bool rejected =
+    corrupt([](BinaryMatrixHeader &header) {
+      header.rows = header.cols = header.stride = std::uint64_t(1) << 62;  // rows * stride * 4 wraps to 0
+    }) &&
+    corrupt([](BinaryMatrixHeader &header) {
+      header.data_offset = ~std::uint64_t(0) - 63;
+    }) &&
+    corrupt([](BinaryMatrixHeader &header) {
+      header.alignment = 16;
+    }) &&
+    corrupt([](BinaryMatrixHeader &header) {
+      header.rows = header.cols = header.stride = 1000;
+    });
+  std::filesystem::remove(file_name);
+
+  return rejected;
+}
+
+static bool test_text_loader() {
+  auto file_name = (std::filesystem::temp_directory_path() / "det_test_matrix.txt").string();
+  {
+    std::ofstream file(file_name);
+    file << "3 3\n1 3 5\n4 0 1\n  2 1 0.5e1\n";
+  }
+  auto matrix = load_matrix_from_file(file_name);
+  std::filesystem::remove(file_name);
+
+  std::vector<std::vector<float>> expected = {
+    {1, 3, 5},
+    {4, 0, 1},
+    {2, 1, 5},
+  };
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    if (!std::ranges::equal(matrix.row(i), expected[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 static bool is_float_equal(float value, float det, float scale = 1.0f) {
     const float abs_epsilon = std::numeric_limits<float>::epsilon();
 
@@ -234,6 +788,18 @@ bool test() {
     {test_high_det, "test_high_det"},
     {test_low_swapped, "test_low_swapped"},
     {test_high_swapped, "test_high_swapped"},
+    {test_minor_view, "test_minor_view"},
+    {test_gauss_det, "test_gauss_det"},
+    {test_gauss_data_files, "test_gauss_data_files"},
+    {test_det_batch, "test_det_batch"},
+    {test_blocked_lu, "test_blocked_lu"},
+    {test_thread_pool, "test_thread_pool"},
+    {test_sparse_det, "test_sparse_det"},
+    {test_determinant_tracker, "test_determinant_tracker"},
+    {test_big_integer, "test_big_integer"},
+    {test_exact_det, "test_exact_det"},
+    {test_binary_round_trip, "test_binary_round_trip"},
+    {test_text_loader, "test_text_loader"},
     {time_high_test, "time_high_test"},
     {time_low_test, "time_low_test"}
   };
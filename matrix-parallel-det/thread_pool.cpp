@@ -0,0 +1,125 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+static thread_local ThreadPool *current_pool = nullptr;
+static thread_local std::size_t current_queue = 0;
+// Stolen tasks run on top of the waiting task's stack, so the chain of
+// nested steals is capped to keep the stack bounded.
+static thread_local std::size_t steal_depth = 0;
+static constexpr std::size_t max_steal_depth = 8;
+
+ThreadPool::ThreadPool(std::size_t threads) {
+  threads = std::max<std::size_t>(threads, 1);
+  _queues.reserve(threads);
+  for (std::size_t i = 0; i < threads; i++) {
+    _queues.push_back(std::make_unique<Queue>());
+  }
+
+  _threads.reserve(threads);
+  for (std::size_t i = 0; i < threads; i++) {
+    _threads.emplace_back(&ThreadPool::worker_loop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(_sleep_mutex);
+    _stop = true;
+  }
+  _wake.notify_all();
+
+  for (auto &thread : _threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  auto idx = current_pool == this ? current_queue : _next_queue.fetch_add(1) % _queues.size();
+  _queued.fetch_add(1);
+  {
+    std::lock_guard lock(_queues[idx]->mutex);
+    _queues[idx]->tasks.push_back(std::move(task));
+  }
+
+  std::lock_guard lock(_sleep_mutex);
+  _wake.notify_one();
+}
+
+bool ThreadPool::pop_local(std::size_t idx, Task &task) {
+  auto &queue = *_queues[idx];
+  std::lock_guard lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::steal(std::size_t thief, Task &task) {
+  for (std::size_t i = 1; i <= _queues.size(); i++) {
+    auto &queue = *_queues[(thief + i) % _queues.size()];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::run_pending_task() {
+  if (_queued.load() == 0) {
+    return false;
+  }
+
+  Task task;
+  bool own = current_pool == this;
+  if (own && pop_local(current_queue, task)) {
+    _queued.fetch_sub(1);
+    task();
+    return true;
+  }
+
+  if (steal_depth < max_steal_depth && steal(own ? current_queue : 0, task)) {
+    _queued.fetch_sub(1);
+    steal_depth++;
+    task();
+    steal_depth--;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::worker_loop(std::size_t idx) {
+  current_pool = this;
+  current_queue = idx;
+
+  while (true) {
+    if (run_pending_task()) {
+      continue;
+    }
+
+    std::unique_lock lock(_sleep_mutex);
+    _wake.wait(lock, [this]() {
+      return _stop.load() || _queued.load() != 0;
+    });
+    if (_stop.load() && _queued.load() == 0) {
+      return;
+    }
+  }
+}
+
+std::shared_ptr<ThreadPool> shared_pool(std::size_t threads) {
+  static std::shared_ptr<ThreadPool> pool;
+  static std::mutex mutex;
+
+  std::lock_guard lock(mutex);
+  threads = std::max<std::size_t>(threads, 1);
+  if (!pool || pool->size() != threads) {
+    pool = std::make_shared<ThreadPool>(threads);
+  }
+  return pool;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Work-stealing pool: every worker owns a deque, pops its own tasks from the
+// back and steals from the front of the others when it runs dry. Threads
+// that wait on a TaskGroup execute queued tasks instead of blocking, so
+// nested fork/join never deadlocks.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(std::size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  void submit(Task task);
+  bool run_pending_task();
+
+  std::size_t size() const {
+    return _threads.size();
+  }
+
+private:
+  struct Queue {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+  };
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::vector<std::thread> _threads;
+  std::atomic<std::size_t> _queued = 0;
+  std::atomic<std::size_t> _next_queue = 0;
+  std::atomic<bool> _stop = false;
+  std::mutex _sleep_mutex;
+  std::condition_variable _wake;
+
+  bool pop_local(std::size_t idx, Task &task);
+  bool steal(std::size_t thief, Task &task);
+  void worker_loop(std::size_t idx);
+};
+
+// Tasks may capture the caller's locals by reference, so the destructor
+// waits for every task even when the scope is left by an exception. An
+// exception thrown by a task is kept and rethrown by wait(); the task
+// still counts as finished.
+class TaskGroup {
+  ThreadPool &_pool;
+  std::atomic<std::size_t> _pending = 0;
+  std::mutex _error_mutex;
+  std::exception_ptr _error;
+
+  void drain() {
+    while (_pending.load() != 0) {
+      if (!_pool.run_pending_task()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+public:
+  explicit TaskGroup(ThreadPool &pool) : _pool(pool) {}
+  ~TaskGroup() {
+    drain();
+  }
+
+  template <typename F>
+  void run(F &&func) {
+    _pending.fetch_add(1);
+    try {
+      _pool.submit([this, func = std::forward<F>(func)]() mutable {
+        try {
+          func();
+        } catch (...) {
+          std::lock_guard lock(_error_mutex);
+          if (!_error) {
+            _error = std::current_exception();
+          }
+        }
+        // Last access to the group: once it reaches zero the owner may
+        // destroy it.
+        _pending.fetch_sub(1);
+      });
+    } catch (...) {
+      _pending.fetch_sub(1);
+      throw;
+    }
+  }
+
+  void wait() {
+    drain();
+    if (_error) {
+      std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+  }
+};
+
+// Pool shared by the determinant engines. A call with a different size
+// replaces it for later callers; earlier ones keep theirs alive through the
+// returned pointer, so a resize never pulls a pool out from under a run.
+std::shared_ptr<ThreadPool> shared_pool(std::size_t threads);